@@ -23,22 +23,33 @@
  */
 
 #include "MainWindow.hpp"
+#include "playerIndex.hpp"
 
 #include "json.hpp"
 
 #include <fstream>
 #include <iostream>
+#include <random>
+#include <thread>
 
 #include <QInputDialog>
 #include <QMessageBox>
 #include <QLocale>
 #include <QFileDialog>
+#include <QActionGroup>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QStandardPaths>
 
 #define maxMatchs 5
 
 constexpr const char* PLAYER_LBL = "players";
 constexpr const char* MATCHES_LBL = "matches";
 constexpr const char* MATCH_CNT_LBL = "match_count";
+constexpr const char* SEED_LBL = "seed";
+constexpr const char* AUTOSAVE_FILE = "recovery.json";
+constexpr std::int32_t LIVE_STANDINGS_COUNT = 16;
 
 void MainWindow::setupWindow()
 {
@@ -55,14 +66,41 @@ void MainWindow::setupWindow()
 
     connect(m_ui->calcTourneyResB, &QPushButton::clicked, this, &MainWindow::calcFinalResult);
 
+    using namespace std::placeholders;
+    connect(m_ui->match1T, &QTableWidget::cellChanged, std::bind(&MainWindow::resultEntered, this, 0, _1, _2));
+    connect(m_ui->match2T, &QTableWidget::cellChanged, std::bind(&MainWindow::resultEntered, this, 1, _1, _2));
+    connect(m_ui->match3T, &QTableWidget::cellChanged, std::bind(&MainWindow::resultEntered, this, 2, _1, _2));
+    connect(m_ui->match4T, &QTableWidget::cellChanged, std::bind(&MainWindow::resultEntered, this, 3, _1, _2));
+    connect(m_ui->match5T, &QTableWidget::cellChanged, std::bind(&MainWindow::resultEntered, this, 4, _1, _2));
+
     connect(m_ui->actionSave_Player_List_and_Tournament, &QAction::triggered, this, &MainWindow::save);
     connect(m_ui->actionLoad_Player_List_and_Tournament, &QAction::triggered, this, &MainWindow::load);
+    connect(m_ui->actionRecover_Last_Session, &QAction::triggered, this, &MainWindow::recoverSession);
 
     connect(m_ui->actionClear_Tournament, &QAction::triggered, this, &MainWindow::clearTournament);
     connect(m_ui->actionClear_Players_and_Tournament, &QAction::triggered, this, &MainWindow::clearAll);
+    connect(m_ui->actionShow_Live_Standings, &QAction::triggered, this, &MainWindow::showLiveStandings);
 
     connect(m_ui->roundCount, &QSpinBox::valueChanged, this, &MainWindow::updateMatchCount);
 
+    auto pairingGroup = new QActionGroup(this);
+    pairingGroup->addAction(m_ui->actionBacktracking_Pairing);
+    pairingGroup->addAction(m_ui->actionWeighted_Matching_Pairing);
+    pairingGroup->addAction(m_ui->actionScore_Bracket_Pairing);
+    pairingGroup->addAction(m_ui->actionTime_Limited_Pairing);
+    connect(m_ui->actionBacktracking_Pairing, &QAction::triggered, std::bind(&MainWindow::setPairingMethod, this, PairingMethod::Backtracking));
+    connect(m_ui->actionWeighted_Matching_Pairing, &QAction::triggered, std::bind(&MainWindow::setPairingMethod, this, PairingMethod::WeightedMatching));
+    connect(m_ui->actionScore_Bracket_Pairing, &QAction::triggered, std::bind(&MainWindow::setPairingMethod, this, PairingMethod::ScoreBrackets));
+    connect(m_ui->actionTime_Limited_Pairing, &QAction::triggered, this, &MainWindow::setTimeLimitedPairing);
+    connect(m_ui->actionParallel_Pairing, &QAction::toggled, this, &MainWindow::setParallelPairing);
+    connect(m_ui->actionDeterministic_Pairing, &QAction::toggled, this, &MainWindow::setDeterministicPairing);
+
+    auto tiebreakGroup = new QActionGroup(this);
+    tiebreakGroup->addAction(m_ui->actionMtG_Tiebreaks);
+    tiebreakGroup->addAction(m_ui->actionChess_Tiebreaks);
+    connect(m_ui->actionMtG_Tiebreaks, &QAction::triggered, std::bind(&MainWindow::setTiebreakRules, this, TiebreakRules::Mtg));
+    connect(m_ui->actionChess_Tiebreaks, &QAction::triggered, std::bind(&MainWindow::setTiebreakRules, this, TiebreakRules::Chess));
+
     m_ui->calcTourneyResB->setEnabled(false);
     m_ui->calcTourneyResB->setVisible(false);
 
@@ -72,6 +110,10 @@ void MainWindow::setupWindow()
     m_matches.emplace_back(m_ui->match3B, m_ui->match3T);
     m_matches.emplace_back(m_ui->match4B, m_ui->match4T);
     m_matches.emplace_back(m_ui->match5B, m_ui->match5T);
+
+    newSeed();
+    setParallelPairing(m_ui->actionParallel_Pairing->isChecked());
+    setDeterministicPairing(m_ui->actionDeterministic_Pairing->isChecked());
 }
 
 void MainWindow::addPlayer()
@@ -80,16 +122,12 @@ void MainWindow::addPlayer()
     QString text = QInputDialog::getText(this, tr("Add Player"), tr("Player Name"), QLineEdit::Normal, "", &ok);
     if (ok && !text.isEmpty())
     {
-        int32_t index = 0;
-        for (const auto &player : m_players)
-        {
-            if (player->getId() >= index)
-                index = player->getId() + 1;
-        }
-        m_players.emplace_back(std::make_shared<Player>(text, index));
+        //removed players keep their ids, earlier results still refer to them
+        m_players.emplace_back(m_playerTable.create(text));
 
         //update list
         updatePlayerList();
+        repairCurrentMatch();
     }
 }
 
@@ -107,6 +145,22 @@ void MainWindow::removePlayer()
     }
 
     updatePlayerList();
+    repairCurrentMatch();
+}
+
+void MainWindow::repairCurrentMatch()
+{
+    //only the latest generated match is still in play, earlier ones are history
+    //and once results are in its pairings are left alone
+    for (auto i = m_matches.size() - 1; i >= 0; i--)
+    {
+        if (m_matches[i].isGenerated())
+        {
+            if (!m_matches[i].hasResults() && m_matches[i].repairMatch(m_players, i))
+                autosave();
+            return;
+        }
+    }
 }
 
 void MainWindow::editPlayerName()
@@ -148,6 +202,8 @@ void MainWindow::updatePlayerList()
         players.push_back(play->getName());
     }
     m_playerList.setStringList(players);
+    m_liveStandings.setPlayers(m_players);
+    updateLiveStandings();
     updatePlayerCount();
 }
 
@@ -189,10 +245,12 @@ void MainWindow::setMatchCount(int matchCount)
 
 void MainWindow::save()
 {
-    //first thing, finalize all results in the table
+    //first thing, finalize the matches whose results are all in
+    //rows of the others were committed as they were entered, and the current match can still be repaired
     for (int i = 0; i < m_matches.size(); i++)
     {
-        m_matches[i].finalizeMatch(m_players, i);
+        if (m_matches[i].isComplete())
+            m_matches[i].finalizeMatch(m_playerTable, m_players, i);
     }
 
     const auto savePath = QFileDialog::getSaveFileName(this, "Save Match", "", "*.json");
@@ -201,11 +259,59 @@ void MainWindow::save()
         return;
     }
 
+    writeTournament(savePath);
+}
+
+void MainWindow::load()
+{
+    const auto openPath = QFileDialog::getOpenFileName(this, "Open Match", "", "*.json");
+    if (openPath.isEmpty())
+    {
+        return;
+    }
+
+    readTournament(openPath);
+}
+
+void MainWindow::autosave()
+{
+    const auto dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    if (dir.isEmpty() || !QDir().mkpath(dir))
+    {
+        std::cerr << "no writable location for the recovery file\n";
+        return;
+    }
+    writeTournament(autosavePath());
+}
+
+void MainWindow::recoverSession()
+{
+    const auto path = autosavePath();
+    if (!QFileInfo::exists(path))
+    {
+        QMessageBox dialog;
+        dialog.setWindowTitle(tr("Recover Last Session"));
+        dialog.setText(tr("There is no session to recover."));
+        dialog.exec();
+        return;
+    }
+
+    //the pairings are stored in the recovery file, so nothing has to be searched again
+    readTournament(path);
+}
+
+QString MainWindow::autosavePath() const
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/" + AUTOSAVE_FILE;
+}
+
+void MainWindow::writeTournament(const QString &path)
+{
     //open output file
-    std::ofstream outFile(savePath.toStdString());
+    std::ofstream outFile(path.toStdString());
     if (!outFile.is_open())
     {
-        std::cerr << "failed to open " << savePath.toStdString() << " for writing\n";
+        std::cerr << "failed to open " << path.toStdString() << " for writing\n";
         return;
     }
 
@@ -214,6 +320,9 @@ void MainWindow::save()
     //save number of rounds
     j[MATCH_CNT_LBL] = m_matchCount;
 
+    //save the seed so regenerated matches shuffle the same way
+    j[SEED_LBL] = m_seed;
+
     //generate player list
     auto& playerJ = j[PLAYER_LBL];
     for (const auto& p : m_players)
@@ -231,19 +340,13 @@ void MainWindow::save()
     outFile << j.dump(4);
 }
 
-void MainWindow::load()
+void MainWindow::readTournament(const QString &path)
 {
-    const auto openPath = QFileDialog::getOpenFileName(this, "Open Match", "", "*.json");
-    if (openPath.isEmpty())
-    {
-        return;
-    }
-
     //open input file
-    std::ifstream inFile(openPath.toStdString());
+    std::ifstream inFile(path.toStdString());
     if (!inFile.is_open())
     {
-        std::cerr << "failed to open " << openPath.toStdString() << " for reading\n";
+        std::cerr << "failed to open " << path.toStdString() << " for reading\n";
         return;
     }
 
@@ -254,6 +357,11 @@ void MainWindow::load()
 
         clearAll(); //clear data after json loaded successfully
 
+        if (j.contains(SEED_LBL)) //older save files get the new seed from clearAll
+        {
+            setSeed(j[SEED_LBL].get<std::uint64_t>());
+        }
+
         //player list
         if (!j.contains(PLAYER_LBL))
         {
@@ -264,12 +372,15 @@ void MainWindow::load()
         {
             m_players.emplace_back(std::make_shared<Player>());
             m_players.back()->load(p);
+            m_playerTable.add(m_players.back());
         }
 
         //finalize opponents now that match results are all loaded and we have a full player list
+        //names are hashed once, so resolving every opponent and pairing stays linear
+        const PlayerIndex index(m_players);
         for (auto& p : m_players)
         {
-            p->finalizeLoad(m_players);
+            p->finalizeLoad(index);
         }
 
         //finally ready to update the list view
@@ -296,18 +407,43 @@ void MainWindow::load()
                 break;
             }
 
-            m_matches[idx].loadMatch(match, m_players, idx);
+            m_matches[idx].loadMatch(match, index, idx);
             idx++;
         }
+
+        //standings snapshots aren't saved, rebuild them for the matches whose results are all in
+        //so the final results still show the rank movement after a reload
+        for (std::size_t i = 0; i < idx; i++)
+        {
+            if (m_matches[i].isComplete())
+            {
+                m_matches[i].captureStandings(m_playerTable, m_players, static_cast<std::int32_t>(i));
+            }
+        }
         checkCalcTourney();
     }
     catch(const std::exception& e)
     {
-        std::cerr << "failed to parse " << openPath.toStdString() << " as a valid tournament\n";
+        std::cerr << "failed to parse " << path.toStdString() << " as a valid tournament\n";
         std::cerr << e.what() << std::endl;
     }
 }
 
+void MainWindow::setSeed(std::uint64_t seed)
+{
+    m_seed = seed;
+    for (auto& match : m_matches)
+    {
+        match.setSeed(seed);
+    }
+}
+
+void MainWindow::newSeed()
+{
+    std::random_device rd;
+    setSeed((static_cast<std::uint64_t>(rd()) << 32) | rd());
+}
+
 
 void MainWindow::clearTournament()
 {
@@ -315,6 +451,7 @@ void MainWindow::clearTournament()
     {
         match.reset();
     }
+    newSeed(); //a new tournament shuffles differently
     checkCalcTourney();
 }
 
@@ -322,9 +459,67 @@ void MainWindow::clearAll()
 {
     clearTournament();
     m_players.clear();
+    m_playerTable.clear();
     updatePlayerList();
 }
 
+void MainWindow::setPairingMethod(PairingMethod method)
+{
+    for (auto& match : m_matches)
+    {
+        match.setPairingMethod(method);
+    }
+}
+
+void MainWindow::setTimeLimitedPairing()
+{
+    bool ok;
+    const auto seconds = QInputDialog::getInt(this, tr("Time Limited Search"), tr("Seconds per round"), m_matches.front().getPairingTimeLimit(), 1, 3600, 1, &ok);
+    if (!ok)
+    {
+        //the group already checked the time limited action, put the check back on the method still in use
+        const auto method = m_matches.front().getPairingMethod();
+        if (method == PairingMethod::Backtracking)
+            m_ui->actionBacktracking_Pairing->setChecked(true);
+        else if (method == PairingMethod::WeightedMatching)
+            m_ui->actionWeighted_Matching_Pairing->setChecked(true);
+        else if (method == PairingMethod::ScoreBrackets)
+            m_ui->actionScore_Bracket_Pairing->setChecked(true);
+        return;
+    }
+
+    for (auto& match : m_matches)
+    {
+        match.setPairingTimeLimit(seconds);
+        match.setPairingMethod(PairingMethod::TimeLimited);
+    }
+}
+
+void MainWindow::setParallelPairing(bool parallel)
+{
+    const auto numThreads = parallel ? static_cast<std::int32_t>(std::thread::hardware_concurrency()) : 1;
+    for (auto& match : m_matches)
+    {
+        match.setPairingThreads(numThreads);
+    }
+}
+
+void MainWindow::setTiebreakRules(TiebreakRules rules)
+{
+    for (auto& match : m_matches)
+    {
+        match.setTiebreakRules(rules);
+    }
+}
+
+void MainWindow::setDeterministicPairing(bool deterministic)
+{
+    for (auto& match : m_matches)
+    {
+        match.setDeterministicPairing(deterministic);
+    }
+}
+
 void MainWindow::checkCalcTourney()
 {
     if (m_matchCount <= 0)
@@ -353,44 +548,102 @@ void MainWindow::generateMatch(int matchNum)
 {
     bool genNext = true;
     if (matchNum > 0)
-        genNext = m_matches[matchNum - 1].finalizeMatch(m_players, matchNum - 1);
+        genNext = m_matches[matchNum - 1].finalizeMatch(m_playerTable, m_players, matchNum - 1);
     if (!genNext)
         return;
     m_matches[matchNum].reset();
     m_matches[matchNum].generateMatch(m_players, matchNum);
     checkCalcTourney();
+    updateLiveStandings();
+    autosave();
+}
+
+void MainWindow::resultEntered(int matchNum, int row, int column)
+{
+    if (column < 2) //player names
+        return;
+    if (m_matches[matchNum].commitResult(row, matchNum))
+    {
+        updateLiveStandings();
+        autosave(); //a crash shouldn't lose results already typed in
+    }
+}
+
+void MainWindow::showLiveStandings()
+{
+    if (m_liveStandingsView == nullptr)
+    {
+        m_liveStandingsView = new QMessageBox(this);
+        m_liveStandingsView->setWindowTitle(tr("Live Standings"));
+        m_liveStandingsView->setModal(false);
+    }
+    m_liveStandingsView->show();
+    m_liveStandingsView->raise();
+    updateLiveStandings();
+}
+
+void MainWindow::updateLiveStandings()
+{
+    if (m_liveStandingsView == nullptr || !m_liveStandingsView->isVisible())
+        return;
+
+    //only the players whose results changed (and their opponents) are recomputed, see LiveStandings
+    m_liveStandings.refresh();
+
+    QString message;
+    QTextStream messageBuilder(&message);
+    QLocale locale;
+    for (const auto &entry : m_liveStandings.getTop(LIVE_STANDINGS_COUNT))
+    {
+        messageBuilder << locale.toString(entry.place) << ": " << QString::fromStdString(entry.player->getName()) << tr(", M:") << locale.toString(entry.matchScore) << tr(", G:") << locale.toString(entry.gameScore)
+                       << tr(", OMWP:") << locale.toString(entry.opponentMatchWinPercentage, 'f', 2) << "\n";
+    }
+    m_liveStandingsView->setText(message);
 }
 
 void MainWindow::calcFinalResult()
 {
-    if (!m_matches[m_matchCount - 1].finalizeMatch(m_players, m_matchCount - 1))
+    if (!m_matches[m_matchCount - 1].finalizeMatch(m_playerTable, m_players, m_matchCount - 1))
     {
         return;
     }
-    auto sortedList = m_players;
+    updateLiveStandings();
+    //the final match just captured the standings, the match before it gives the rank movement
+    const auto standings = m_matches[m_matchCount - 1].getStandings();
+    const auto previous = m_matchCount > 1 ? m_matches[m_matchCount - 2].getStandings() : nullptr;
+
+    const bool chess = m_matches[m_matchCount - 1].getTiebreakRules() == TiebreakRules::Chess;
 
-    std::sort(sortedList.begin(), sortedList.end(), [](std::shared_ptr<Player> p1, std::shared_ptr<Player> p2)
-              { return p1->getTiebrokenScore() > p2->getTiebrokenScore(); });
+    QHash<std::int32_t, QString> names;
+    for (const auto &player : m_players)
+    {
+        names.insert(player->getId(), player->getName());
+    }
 
     QString message;
     QTextStream messageBuilder(&message);
-    std::int32_t place = 1;
-    std::int32_t iterSize = 1;
     QLocale locale;
-    for (std::int32_t i = 0; i < sortedList.size(); i++)
+    for (const auto &entry : standings->getEntries())
     {
-        messageBuilder << locale.toString(place) << ": " << sortedList[i]->getName() << tr(", M:") << locale.toString(sortedList[i]->getMatchScore()) << tr(", G:") << locale.toString(sortedList[i]->getGameScore())
-                       << tr(", MWP:") << locale.toString(sortedList[i]->getMatchWinPercentage(), 'f', 2) << tr(", GWP:") << locale.toString(sortedList[i]->getGameWinPercentage(), 'f', 2)
-                       << tr(", OMWP:") << locale.toString(sortedList[i]->getOpponentMatchWinPercentage(), 'f', 2) << tr(", OGWP:") << locale.toString(sortedList[i]->getOpponentGameWinPercentage(), 'f', 2) << "\n";
-        if (((i + 1) < sortedList.size()) && (sortedList[i]->getTiebrokenScore() == sortedList[i + 1]->getTiebrokenScore()))
+        const auto &values = entry.key.values;
+        messageBuilder << locale.toString(entry.place) << ": " << names.value(entry.playerId);
+        if (chess)
         {
-            iterSize++;
+            messageBuilder << tr(", M:") << locale.toString(values[TiebreakKey::POINTS]) << tr(", MBH:") << locale.toString(values[TiebreakKey::MEDIAN_BUCHHOLZ]) << tr(", BH:") << locale.toString(values[TiebreakKey::BUCHHOLZ])
+                           << tr(", SB:") << locale.toString(values[TiebreakKey::SONNEBORN_BERGER]) << tr(", PS:") << locale.toString(values[TiebreakKey::PROGRESSIVE_SCORE]);
         }
         else
         {
-            place += iterSize;
-            iterSize = 1;
+            messageBuilder << tr(", M:") << locale.toString(values[TiebreakKey::MATCH_SCORE]) << tr(", G:") << locale.toString(values[TiebreakKey::GAME_SCORE])
+                           << tr(", MWP:") << locale.toString(TiebreakKey::percentage(values[TiebreakKey::MATCH_WIN_PERCENTAGE]), 'f', 2) << tr(", GWP:") << locale.toString(TiebreakKey::percentage(values[TiebreakKey::GAME_WIN_PERCENTAGE]), 'f', 2)
+                           << tr(", OMWP:") << locale.toString(TiebreakKey::percentage(values[TiebreakKey::OPP_MATCH_WIN_PERCENTAGE]), 'f', 2) << tr(", OGWP:") << locale.toString(TiebreakKey::percentage(values[TiebreakKey::OPP_GAME_WIN_PERCENTAGE]), 'f', 2);
+        }
+        if (previous != nullptr)
+        {
+            const auto movement = standings->getMovement(*previous, entry.playerId);
+            messageBuilder << tr(", Moved:") << (movement > 0 ? "+" : "") << locale.toString(movement);
         }
+        messageBuilder << "\n";
     }
 
     QMessageBox dialog;
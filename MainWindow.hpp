@@ -27,8 +27,11 @@
 #include "ui_MainWindow.h"
 
 #include "player.hpp"
+#include "playerTable.hpp"
+#include "liveStandings.hpp"
 #include "match.hpp"
 #include <QList>
+#include <QMessageBox>
 #include <QStringListModel>
 
 class MainWindow : public QMainWindow
@@ -51,6 +54,10 @@ public slots:
     void generateMatch(int matchNum);
     void calcFinalResult();
 
+    //a cell of a match table was edited, commits the row's result once it's complete
+    void resultEntered(int matchNum, int row, int column);
+    void showLiveStandings();
+
     void updatePlayerList();
 
     void updatePlayerCount();
@@ -61,17 +68,45 @@ public slots:
 
     void save();
     void load();
+    void recoverSession();
 
     void clearTournament();
     void clearAll();
 
+    void setPairingMethod(PairingMethod method);
+    void setTimeLimitedPairing();
+    void setParallelPairing(bool parallel);
+    void setDeterministicPairing(bool deterministic);
+
+    void setTiebreakRules(TiebreakRules rules);
+
 
 private:
+    //re-pair the latest generated match after players were added or removed
+    void repairCurrentMatch();
+
+    //recovery file written after every generated match, so a crash never loses the pairings
+    void autosave();
+    QString autosavePath() const;
+
+    //rewrites the live standings window, if it's open
+    void updateLiveStandings();
+
+    void writeTournament(const QString &path);
+    void readTournament(const QString &path);
+
+    void setSeed(std::uint64_t seed);
+    void newSeed();
+
     std::unique_ptr<Ui::MainWindow> m_ui;
 
+    PlayerTable m_playerTable; //every player of the tournament, including the ones removed from m_players
     QList<std::shared_ptr<Player>> m_players;
     QStringListModel m_playerList;
     QList<Match> m_matches;
+    LiveStandings m_liveStandings; //follows m_players, see updatePlayerList
+    QMessageBox *m_liveStandingsView = nullptr; //created on first use, owned by the window
 
     std::int32_t m_matchCount = 0;
+    std::uint64_t m_seed = 0;
 };
@@ -0,0 +1,700 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "blossom.hpp"
+
+#include <algorithm>
+
+//Based on the primal-dual method described by Galil, "Efficient algorithms for finding maximum
+//matching in graphs" (1986), following the structure of Joris van Rantwijk's reference implementation.
+//Edge endpoints are numbered 2k and 2k + 1 for edge k, so p ^ 1 is the opposite end of endpoint p.
+//Vertex labels: 0 = free, 1 = S (outer), 2 = T (inner). Blossoms are numbered numVertices to 2 * numVertices - 1.
+
+namespace
+{
+
+class BlossomMatcher
+{
+public:
+    BlossomMatcher(std::int32_t numVertices, const std::vector<WeightedEdge> &edges)
+        : m_nVertex(numVertices), m_nEdge(static_cast<std::int32_t>(edges.size()))
+    {
+        std::int64_t maxWeight = 0;
+        for (const auto &e : edges)
+        {
+            //weights are doubled so every dual variable and half slack stays integral
+            m_edges.push_back(WeightedEdge{e.u, e.v, e.weight * 2});
+            maxWeight = std::max(maxWeight, e.weight * 2);
+        }
+
+        m_endpoint.resize(2 * m_nEdge);
+        m_neighbend.resize(m_nVertex);
+        for (std::int32_t k = 0; k < m_nEdge; k++)
+        {
+            m_endpoint[2 * k] = m_edges[k].u;
+            m_endpoint[2 * k + 1] = m_edges[k].v;
+            m_neighbend[m_edges[k].u].push_back(2 * k + 1);
+            m_neighbend[m_edges[k].v].push_back(2 * k);
+        }
+
+        m_mate.assign(m_nVertex, -1);
+        m_label.assign(2 * m_nVertex, 0);
+        m_labelEnd.assign(2 * m_nVertex, -1);
+        m_inBlossom.resize(m_nVertex);
+        for (std::int32_t v = 0; v < m_nVertex; v++)
+            m_inBlossom[v] = v;
+        m_blossomParent.assign(2 * m_nVertex, -1);
+        m_blossomChilds.resize(2 * m_nVertex);
+        m_blossomBase.assign(2 * m_nVertex, -1);
+        for (std::int32_t v = 0; v < m_nVertex; v++)
+            m_blossomBase[v] = v;
+        m_blossomEndps.resize(2 * m_nVertex);
+        m_bestEdge.assign(2 * m_nVertex, -1);
+        m_blossomBestEdges.resize(2 * m_nVertex);
+        m_hasBlossomBestEdges.assign(2 * m_nVertex, false);
+        for (std::int32_t b = 2 * m_nVertex - 1; b >= m_nVertex; b--)
+            m_unusedBlossoms.push_back(b);
+        m_dualVar.assign(2 * m_nVertex, 0);
+        for (std::int32_t v = 0; v < m_nVertex; v++)
+            m_dualVar[v] = maxWeight;
+        m_allowEdge.assign(m_nEdge, false);
+        m_bestEdgeTo.assign(2 * m_nVertex, -1);
+
+        //all duals start equal, so any edge of maximum weight is tight and can be matched greedily up front
+        //this keeps the stage invariants intact and skips most of the stages for nearly uniform weights
+        for (std::int32_t k = 0; k < m_nEdge; k++)
+        {
+            const auto &e = m_edges[k];
+            if (e.weight == maxWeight && e.u != e.v && m_mate[e.u] == -1 && m_mate[e.v] == -1)
+            {
+                m_mate[e.u] = 2 * k + 1;
+                m_mate[e.v] = 2 * k;
+            }
+        }
+    }
+
+    std::vector<std::int32_t> solve(bool maxCardinality);
+
+private:
+    std::int32_t m_nVertex;
+    std::int32_t m_nEdge;
+    std::vector<WeightedEdge> m_edges;
+    std::vector<std::int32_t> m_endpoint;
+    std::vector<std::vector<std::int32_t>> m_neighbend;
+    std::vector<std::int32_t> m_mate; //remote endpoint of the matched edge, or -1
+    std::vector<std::int32_t> m_label;
+    std::vector<std::int32_t> m_labelEnd;
+    std::vector<std::int32_t> m_inBlossom;
+    std::vector<std::int32_t> m_blossomParent;
+    std::vector<std::vector<std::int32_t>> m_blossomChilds;
+    std::vector<std::int32_t> m_blossomBase;
+    std::vector<std::vector<std::int32_t>> m_blossomEndps;
+    std::vector<std::int32_t> m_bestEdge;
+    std::vector<std::vector<std::int32_t>> m_blossomBestEdges;
+    std::vector<bool> m_hasBlossomBestEdges;
+    std::vector<std::int32_t> m_unusedBlossoms;
+    std::vector<std::int64_t> m_dualVar;
+    std::vector<bool> m_allowEdge;
+    std::vector<std::int32_t> m_queue;
+    std::vector<std::int32_t> m_bestEdgeTo; //scratch space for addBlossom, kept at -1 between calls
+
+    inline std::int64_t slack(std::int32_t k) const
+    {
+        return m_dualVar[m_edges[k].u] + m_dualVar[m_edges[k].v] - 2 * m_edges[k].weight;
+    }
+
+    void blossomLeaves(std::int32_t b, std::vector<std::int32_t> &leaves) const;
+    void assignLabel(std::int32_t w, std::int32_t t, std::int32_t p);
+    std::int32_t scanBlossom(std::int32_t v, std::int32_t w);
+    void addBlossom(std::int32_t base, std::int32_t k);
+    void expandBlossom(std::int32_t b, bool endStage);
+    void augmentBlossom(std::int32_t b, std::int32_t v);
+    void augmentMatching(std::int32_t k);
+};
+
+void BlossomMatcher::blossomLeaves(std::int32_t b, std::vector<std::int32_t> &leaves) const
+{
+    if (b < m_nVertex)
+    {
+        leaves.push_back(b);
+        return;
+    }
+    for (const auto t : m_blossomChilds[b])
+        blossomLeaves(t, leaves);
+}
+
+void BlossomMatcher::assignLabel(std::int32_t w, std::int32_t t, std::int32_t p)
+{
+    //iterative form of the label propagation: a T-blossom always makes its mate an S-blossom
+    while (true)
+    {
+        const auto b = m_inBlossom[w];
+        m_label[w] = m_label[b] = t;
+        m_labelEnd[w] = m_labelEnd[b] = p;
+        m_bestEdge[w] = m_bestEdge[b] = -1;
+        if (t == 1)
+        {
+            blossomLeaves(b, m_queue);
+            return;
+        }
+        const auto base = m_blossomBase[b];
+        w = m_endpoint[m_mate[base]];
+        t = 1;
+        p = m_mate[base] ^ 1;
+    }
+}
+
+std::int32_t BlossomMatcher::scanBlossom(std::int32_t v, std::int32_t w)
+{
+    //trace back from v and w to find either a new blossom base or an augmenting path
+    std::vector<std::int32_t> path;
+    std::int32_t base = -1;
+    while (v != -1 || w != -1)
+    {
+        auto b = m_inBlossom[v];
+        if (m_label[b] & 4)
+        {
+            base = m_blossomBase[b];
+            break;
+        }
+        path.push_back(b);
+        m_label[b] = 5;
+        if (m_labelEnd[b] == -1)
+        {
+            v = -1;
+        }
+        else
+        {
+            v = m_endpoint[m_labelEnd[b]];
+            b = m_inBlossom[v];
+            v = m_endpoint[m_labelEnd[b]];
+        }
+        if (w != -1)
+            std::swap(v, w);
+    }
+    for (const auto b : path)
+        m_label[b] = 1;
+    return base;
+}
+
+void BlossomMatcher::addBlossom(std::int32_t base, std::int32_t k)
+{
+    auto v = m_edges[k].u;
+    auto w = m_edges[k].v;
+    const auto bb = m_inBlossom[base];
+    auto bv = m_inBlossom[v];
+    auto bw = m_inBlossom[w];
+
+    const auto b = m_unusedBlossoms.back();
+    m_unusedBlossoms.pop_back();
+    m_blossomBase[b] = base;
+    m_blossomParent[b] = -1;
+    m_blossomParent[bb] = b;
+
+    auto &path = m_blossomChilds[b];
+    auto &endps = m_blossomEndps[b];
+    path.clear();
+    endps.clear();
+    while (bv != bb)
+    {
+        m_blossomParent[bv] = b;
+        path.push_back(bv);
+        endps.push_back(m_labelEnd[bv]);
+        v = m_endpoint[m_labelEnd[bv]];
+        bv = m_inBlossom[v];
+    }
+    path.push_back(bb);
+    std::reverse(path.begin(), path.end());
+    std::reverse(endps.begin(), endps.end());
+    endps.push_back(2 * k);
+    while (bw != bb)
+    {
+        m_blossomParent[bw] = b;
+        path.push_back(bw);
+        endps.push_back(m_labelEnd[bw] ^ 1);
+        w = m_endpoint[m_labelEnd[bw]];
+        bw = m_inBlossom[w];
+    }
+
+    m_label[b] = 1;
+    m_labelEnd[b] = m_labelEnd[bb];
+    m_dualVar[b] = 0;
+
+    std::vector<std::int32_t> leaves;
+    blossomLeaves(b, leaves);
+    for (const auto leaf : leaves)
+    {
+        //former T-vertices are now part of an S-blossom and need to be scanned
+        if (m_label[m_inBlossom[leaf]] == 2)
+            m_queue.push_back(leaf);
+        m_inBlossom[leaf] = b;
+    }
+
+    //compute the least-slack edges from the new blossom to each neighbouring S-blossom
+    auto &bestEdgeTo = m_bestEdgeTo;
+    std::vector<std::int32_t> touched;
+    for (const auto child : path)
+    {
+        std::vector<std::int32_t> candidates;
+        if (!m_hasBlossomBestEdges[child])
+        {
+            std::vector<std::int32_t> childLeaves;
+            blossomLeaves(child, childLeaves);
+            for (const auto leaf : childLeaves)
+            {
+                for (const auto p : m_neighbend[leaf])
+                    candidates.push_back(p / 2);
+            }
+        }
+        else
+        {
+            candidates = m_blossomBestEdges[child];
+        }
+        for (const auto ek : candidates)
+        {
+            auto j = m_edges[ek].v;
+            if (m_inBlossom[j] == b)
+                j = m_edges[ek].u;
+            const auto bj = m_inBlossom[j];
+            if (bj != b && m_label[bj] == 1 && (bestEdgeTo[bj] == -1 || slack(ek) < slack(bestEdgeTo[bj])))
+            {
+                if (bestEdgeTo[bj] == -1)
+                    touched.push_back(bj);
+                bestEdgeTo[bj] = ek;
+            }
+        }
+        m_blossomBestEdges[child].clear();
+        m_hasBlossomBestEdges[child] = false;
+        m_bestEdge[child] = -1;
+    }
+
+    auto &bestEdges = m_blossomBestEdges[b];
+    bestEdges.clear();
+    std::sort(touched.begin(), touched.end());
+    for (const auto bj : touched)
+    {
+        bestEdges.push_back(bestEdgeTo[bj]);
+        bestEdgeTo[bj] = -1;
+    }
+    m_hasBlossomBestEdges[b] = true;
+    m_bestEdge[b] = -1;
+    for (const auto ek : bestEdges)
+    {
+        if (m_bestEdge[b] == -1 || slack(ek) < slack(m_bestEdge[b]))
+            m_bestEdge[b] = ek;
+    }
+}
+
+void BlossomMatcher::expandBlossom(std::int32_t b, bool endStage)
+{
+    //convert sub-blossoms into top-level blossoms
+    for (const auto s : m_blossomChilds[b])
+    {
+        m_blossomParent[s] = -1;
+        if (s < m_nVertex)
+        {
+            m_inBlossom[s] = s;
+        }
+        else if (endStage && m_dualVar[s] == 0)
+        {
+            expandBlossom(s, endStage);
+        }
+        else
+        {
+            std::vector<std::int32_t> leaves;
+            blossomLeaves(s, leaves);
+            for (const auto leaf : leaves)
+                m_inBlossom[leaf] = s;
+        }
+    }
+
+    //if this is a T-blossom being expanded mid-stage, relabel the sub-blossoms along the even path
+    if (!endStage && m_label[b] == 2)
+    {
+        const auto &childs = m_blossomChilds[b];
+        const auto &endps = m_blossomEndps[b];
+        const auto numChilds = static_cast<std::int32_t>(childs.size());
+        const auto entryChild = m_inBlossom[m_endpoint[m_labelEnd[b] ^ 1]];
+        std::int32_t j = static_cast<std::int32_t>(std::find(childs.begin(), childs.end(), entryChild) - childs.begin());
+        std::int32_t jstep;
+        std::int32_t endptrick;
+        if (j & 1)
+        {
+            j -= numChilds;
+            jstep = 1;
+            endptrick = 0;
+        }
+        else
+        {
+            jstep = -1;
+            endptrick = 1;
+        }
+        auto at = [numChilds](std::int32_t idx) { return idx < 0 ? idx + numChilds : idx; };
+
+        auto p = m_labelEnd[b];
+        while (j != 0)
+        {
+            m_label[m_endpoint[p ^ 1]] = 0;
+            m_label[m_endpoint[endps[at(j - endptrick)] ^ endptrick ^ 1]] = 0;
+            assignLabel(m_endpoint[p ^ 1], 2, p);
+            m_allowEdge[endps[at(j - endptrick)] / 2] = true;
+            j += jstep;
+            p = endps[at(j - endptrick)] ^ endptrick;
+            m_allowEdge[p / 2] = true;
+            j += jstep;
+        }
+
+        auto bv = childs[at(j)];
+        m_label[m_endpoint[p ^ 1]] = m_label[bv] = 2;
+        m_labelEnd[m_endpoint[p ^ 1]] = m_labelEnd[bv] = p;
+        m_bestEdge[bv] = -1;
+        j += jstep;
+        while (childs[at(j)] != entryChild)
+        {
+            bv = childs[at(j)];
+            if (m_label[bv] == 1)
+            {
+                j += jstep;
+                continue;
+            }
+            std::vector<std::int32_t> leaves;
+            blossomLeaves(bv, leaves);
+            std::int32_t labeled = -1;
+            for (const auto leaf : leaves)
+            {
+                if (m_label[leaf] != 0)
+                {
+                    labeled = leaf;
+                    break;
+                }
+            }
+            if (labeled != -1)
+            {
+                m_label[labeled] = 0;
+                m_label[m_endpoint[m_mate[m_blossomBase[bv]]]] = 0;
+                assignLabel(labeled, 2, m_labelEnd[labeled]);
+            }
+            j += jstep;
+        }
+    }
+
+    m_label[b] = m_labelEnd[b] = -1;
+    m_blossomChilds[b].clear();
+    m_blossomEndps[b].clear();
+    m_blossomBase[b] = -1;
+    m_blossomBestEdges[b].clear();
+    m_hasBlossomBestEdges[b] = false;
+    m_bestEdge[b] = -1;
+    m_unusedBlossoms.push_back(b);
+}
+
+void BlossomMatcher::augmentBlossom(std::int32_t b, std::int32_t v)
+{
+    //swap matched/unmatched edges along the even path from v to the base of b
+    auto t = v;
+    while (m_blossomParent[t] != b)
+        t = m_blossomParent[t];
+    if (t >= m_nVertex)
+        augmentBlossom(t, v);
+
+    auto &childs = m_blossomChilds[b];
+    auto &endps = m_blossomEndps[b];
+    const auto numChilds = static_cast<std::int32_t>(childs.size());
+    const auto i = static_cast<std::int32_t>(std::find(childs.begin(), childs.end(), t) - childs.begin());
+    auto j = i;
+    std::int32_t jstep;
+    std::int32_t endptrick;
+    if (i & 1)
+    {
+        j -= numChilds;
+        jstep = 1;
+        endptrick = 0;
+    }
+    else
+    {
+        jstep = -1;
+        endptrick = 1;
+    }
+    auto at = [numChilds](std::int32_t idx) { return idx < 0 ? idx + numChilds : idx; };
+
+    while (j != 0)
+    {
+        j += jstep;
+        t = childs[at(j)];
+        const auto p = endps[at(j - endptrick)] ^ endptrick;
+        if (t >= m_nVertex)
+            augmentBlossom(t, m_endpoint[p]);
+        j += jstep;
+        t = childs[at(j)];
+        if (t >= m_nVertex)
+            augmentBlossom(t, m_endpoint[p ^ 1]);
+        m_mate[m_endpoint[p]] = p ^ 1;
+        m_mate[m_endpoint[p ^ 1]] = p;
+    }
+
+    //rotate so the new base is the first child
+    std::rotate(childs.begin(), childs.begin() + i, childs.end());
+    std::rotate(endps.begin(), endps.begin() + i, endps.end());
+    m_blossomBase[b] = m_blossomBase[childs[0]];
+}
+
+void BlossomMatcher::augmentMatching(std::int32_t k)
+{
+    const std::int32_t starts[2][2] = {{m_edges[k].u, 2 * k + 1}, {m_edges[k].v, 2 * k}};
+    for (const auto &start : starts)
+    {
+        auto s = start[0];
+        auto p = start[1];
+        while (true)
+        {
+            const auto bs = m_inBlossom[s];
+            if (bs >= m_nVertex)
+                augmentBlossom(bs, s);
+            m_mate[s] = p;
+            if (m_labelEnd[bs] == -1)
+                break;
+            const auto t = m_endpoint[m_labelEnd[bs]];
+            const auto bt = m_inBlossom[t];
+            s = m_endpoint[m_labelEnd[bt]];
+            const auto j = m_endpoint[m_labelEnd[bt] ^ 1];
+            if (bt >= m_nVertex)
+                augmentBlossom(bt, j);
+            m_mate[j] = m_labelEnd[bt];
+            p = m_labelEnd[bt] ^ 1;
+        }
+    }
+}
+
+std::vector<std::int32_t> BlossomMatcher::solve(bool maxCardinality)
+{
+    //each stage finds one augmenting path, so there are at most numVertices / 2 useful stages
+    for (std::int32_t stage = 0; stage < m_nVertex; stage++)
+    {
+        std::fill(m_label.begin(), m_label.end(), 0);
+        std::fill(m_bestEdge.begin(), m_bestEdge.end(), -1);
+        for (std::int32_t b = m_nVertex; b < 2 * m_nVertex; b++)
+        {
+            m_blossomBestEdges[b].clear();
+            m_hasBlossomBestEdges[b] = false;
+        }
+        std::fill(m_allowEdge.begin(), m_allowEdge.end(), false);
+        m_queue.clear();
+
+        for (std::int32_t v = 0; v < m_nVertex; v++)
+        {
+            if (m_mate[v] == -1 && m_label[m_inBlossom[v]] == 0)
+                assignLabel(v, 1, -1);
+        }
+
+        bool augmented = false;
+        while (true)
+        {
+            //grow the alternating forest until an augmenting path is found or the queue is empty
+            while (!m_queue.empty() && !augmented)
+            {
+                const auto v = m_queue.back();
+                m_queue.pop_back();
+
+                for (const auto p : m_neighbend[v])
+                {
+                    const auto k = p / 2;
+                    const auto w = m_endpoint[p];
+                    if (m_inBlossom[v] == m_inBlossom[w])
+                        continue;
+                    std::int64_t kslack = 0;
+                    if (!m_allowEdge[k])
+                    {
+                        kslack = slack(k);
+                        if (kslack <= 0)
+                            m_allowEdge[k] = true;
+                    }
+                    if (m_allowEdge[k])
+                    {
+                        if (m_label[m_inBlossom[w]] == 0)
+                        {
+                            assignLabel(w, 2, p ^ 1);
+                        }
+                        else if (m_label[m_inBlossom[w]] == 1)
+                        {
+                            const auto base = scanBlossom(v, w);
+                            if (base >= 0)
+                            {
+                                addBlossom(base, k);
+                            }
+                            else
+                            {
+                                augmentMatching(k);
+                                augmented = true;
+                                break;
+                            }
+                        }
+                        else if (m_label[w] == 0)
+                        {
+                            m_label[w] = 2;
+                            m_labelEnd[w] = p ^ 1;
+                        }
+                    }
+                    else if (m_label[m_inBlossom[w]] == 1)
+                    {
+                        const auto b = m_inBlossom[v];
+                        if (m_bestEdge[b] == -1 || kslack < slack(m_bestEdge[b]))
+                            m_bestEdge[b] = k;
+                    }
+                    else if (m_label[w] == 0)
+                    {
+                        if (m_bestEdge[w] == -1 || kslack < slack(m_bestEdge[w]))
+                            m_bestEdge[w] = k;
+                    }
+                }
+            }
+
+            if (augmented)
+                break;
+
+            //no augmenting path yet, so adjust the dual variables
+            std::int32_t deltaType = -1;
+            std::int64_t delta = 0;
+            std::int32_t deltaEdge = -1;
+            std::int32_t deltaBlossom = -1;
+
+            if (!maxCardinality)
+            {
+                deltaType = 1;
+                delta = *std::min_element(m_dualVar.begin(), m_dualVar.begin() + m_nVertex);
+            }
+            for (std::int32_t v = 0; v < m_nVertex; v++)
+            {
+                if (m_label[m_inBlossom[v]] == 0 && m_bestEdge[v] != -1)
+                {
+                    const auto d = slack(m_bestEdge[v]);
+                    if (deltaType == -1 || d < delta)
+                    {
+                        delta = d;
+                        deltaType = 2;
+                        deltaEdge = m_bestEdge[v];
+                    }
+                }
+            }
+            for (std::int32_t b = 0; b < 2 * m_nVertex; b++)
+            {
+                if (m_blossomParent[b] == -1 && m_label[b] == 1 && m_bestEdge[b] != -1)
+                {
+                    const auto d = slack(m_bestEdge[b]) / 2;
+                    if (deltaType == -1 || d < delta)
+                    {
+                        delta = d;
+                        deltaType = 3;
+                        deltaEdge = m_bestEdge[b];
+                    }
+                }
+            }
+            for (std::int32_t b = m_nVertex; b < 2 * m_nVertex; b++)
+            {
+                if (m_blossomBase[b] >= 0 && m_blossomParent[b] == -1 && m_label[b] == 2 && (deltaType == -1 || m_dualVar[b] < delta))
+                {
+                    delta = m_dualVar[b];
+                    deltaType = 4;
+                    deltaBlossom = b;
+                }
+            }
+            if (deltaType == -1)
+            {
+                //no further improvement possible with max cardinality, do a final delta update to make the optimum verifiable
+                deltaType = 1;
+                delta = std::max<std::int64_t>(0, *std::min_element(m_dualVar.begin(), m_dualVar.begin() + m_nVertex));
+            }
+
+            for (std::int32_t v = 0; v < m_nVertex; v++)
+            {
+                if (m_label[m_inBlossom[v]] == 1)
+                    m_dualVar[v] -= delta;
+                else if (m_label[m_inBlossom[v]] == 2)
+                    m_dualVar[v] += delta;
+            }
+            for (std::int32_t b = m_nVertex; b < 2 * m_nVertex; b++)
+            {
+                if (m_blossomBase[b] >= 0 && m_blossomParent[b] == -1)
+                {
+                    if (m_label[b] == 1)
+                        m_dualVar[b] += delta;
+                    else if (m_label[b] == 2)
+                        m_dualVar[b] -= delta;
+                }
+            }
+
+            if (deltaType == 1)
+            {
+                break;
+            }
+            else if (deltaType == 2)
+            {
+                m_allowEdge[deltaEdge] = true;
+                auto i = m_edges[deltaEdge].u;
+                if (m_label[m_inBlossom[i]] == 0)
+                    i = m_edges[deltaEdge].v;
+                m_queue.push_back(i);
+            }
+            else if (deltaType == 3)
+            {
+                m_allowEdge[deltaEdge] = true;
+                m_queue.push_back(m_edges[deltaEdge].u);
+            }
+            else
+            {
+                expandBlossom(deltaBlossom, false);
+            }
+        }
+
+        if (!augmented)
+            break;
+
+        //expand S-blossoms with zero dual at the end of the stage
+        for (std::int32_t b = m_nVertex; b < 2 * m_nVertex; b++)
+        {
+            if (m_blossomParent[b] == -1 && m_blossomBase[b] >= 0 && m_label[b] == 1 && m_dualVar[b] == 0)
+                expandBlossom(b, true);
+        }
+    }
+
+    std::vector<std::int32_t> mates(m_nVertex, -1);
+    for (std::int32_t v = 0; v < m_nVertex; v++)
+    {
+        if (m_mate[v] >= 0)
+            mates[v] = m_endpoint[m_mate[v]];
+    }
+    return mates;
+}
+
+} // namespace
+
+std::vector<std::int32_t> maxWeightMatching(std::int32_t numVertices, const std::vector<WeightedEdge> &edges, bool maxCardinality)
+{
+    if (numVertices <= 0)
+        return {};
+    if (edges.empty())
+        return std::vector<std::int32_t>(numVertices, -1);
+
+    BlossomMatcher matcher(numVertices, edges);
+    return matcher.solve(maxCardinality);
+}
@@ -0,0 +1,108 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "blossom.hpp"
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+//edge weights for weighted matching pairings
+//penalties are scaled so repeated byes are avoided before rematches, and rematches before score differences
+constexpr std::int64_t PAIRING_BASE_WEIGHT = 10000000000000;
+constexpr std::int64_t PAIRING_BYE_PENALTY = 10000000000; //per previous bye
+constexpr std::int64_t PAIRING_REMATCH_PENALTY = 100000000; //per previous matchup
+constexpr std::int32_t PAIRING_WINDOW = 16; //initial number of following players (by score) considered as opponents
+
+//uniform draw in [0, bound)
+//std::uniform_int_distribution is implementation defined, this gives the same draws on every platform
+std::uint64_t boundedRandom(std::mt19937_64 &reng, std::uint64_t bound);
+
+//random engine for the pairings of a match
+//seed_seq and mt19937_64 are fully specified by the standard, so a seed shuffles the same everywhere
+std::mt19937_64 pairingEngine(std::uint64_t seed, std::int32_t matchNum);
+
+//Fisher-Yates shuffle of the field before pairing, used by Match and Tournament so both pair the same for a seed
+template<typename List>
+void shuffleField(List &list, std::mt19937_64 &reng)
+{
+    for (std::size_t i = list.size(); i > 1; i--)
+        std::swap(list[i - 1], list[boundedRandom(reng, i)]);
+}
+
+//maximum weight matching pairing of a field sorted by match score (best first)
+//timesPlayed(i, j) gives the previous matchups of field positions i and j
+//returns the mate of each position, numPlayers for the position getting the bye, nothing for an empty field
+template<typename TimesPlayed>
+std::vector<std::int32_t> weightedPairing(const std::vector<std::int64_t> &scores, const std::vector<std::int64_t> &byes, TimesPlayed timesPlayed)
+{
+    if (scores.empty())
+        return {};
+
+    //odd fields get an extra vertex representing the bye
+    const auto numPlayers = static_cast<std::int32_t>(scores.size());
+    const bool hasBye = (numPlayers & 1) != 0;
+    const auto byeVertex = numPlayers;
+    const auto numVertices = numPlayers + (hasBye ? 1 : 0);
+
+    //players are sorted by score, so only connect each player to the next few players in the list
+    //consecutive players and the bye always give a perfect matching, but a rematch or repeated bye may only be
+    //avoidable with an opponent outside the window, so the window is doubled until the pairing has no penalty,
+    //covers the whole field, or stops lowering the penalty (it often can't be avoided in small fields and late rounds)
+    std::int64_t lastPenalty = INT64_MAX;
+    for (std::int32_t window = PAIRING_WINDOW;; window *= 2)
+    {
+        std::vector<WeightedEdge> edges;
+        for (std::int32_t i = 0; i < numPlayers; i++)
+        {
+            for (std::int32_t j = i + 1; j < numPlayers && j <= i + window; j++)
+            {
+                const auto scoreDiff = scores[i] - scores[j];
+                const std::int64_t matchups = timesPlayed(i, j);
+                edges.push_back(WeightedEdge{i, j, PAIRING_BASE_WEIGHT - scoreDiff * scoreDiff - matchups * PAIRING_REMATCH_PENALTY});
+            }
+            if (hasBye) //prefer giving the bye to low scoring players without previous byes
+                edges.push_back(WeightedEdge{i, byeVertex, PAIRING_BASE_WEIGHT - scores[i] * scores[i] - byes[i] * PAIRING_BYE_PENALTY});
+        }
+
+        auto mates = maxWeightMatching(numVertices, edges, true);
+        mates.resize(numPlayers);
+
+        std::int64_t penalty = 0;
+        for (std::int32_t i = 0; i < numPlayers; i++)
+        {
+            if (mates[i] == byeVertex)
+                penalty += byes[i] * PAIRING_BYE_PENALTY;
+            else if (mates[i] > i)
+                penalty += timesPlayed(i, mates[i]) * PAIRING_REMATCH_PENALTY;
+        }
+        if (penalty == 0 || penalty >= lastPenalty || window >= numPlayers - 1)
+            return mates;
+        lastPenalty = penalty;
+    }
+}
@@ -0,0 +1,177 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "liveStandings.hpp"
+#include "opponentAverages.hpp"
+
+#include <algorithm>
+
+void LiveStandings::setPlayers(const QList<std::shared_ptr<Player>> &playerList)
+{
+    for (const auto &player : m_players)
+        disconnect(player.get(), &Player::resultsChanged, this, nullptr);
+
+    m_players = playerList;
+    m_entries.clear();
+    m_indexById.clear();
+    m_dirtyList.clear();
+    m_entries.resize(playerList.size());
+    m_opponents.assign(playerList.size(), {});
+    m_dependents.assign(playerList.size(), {});
+    m_dirty.assign(playerList.size(), false);
+    m_ranking.reset(playerList.size());
+
+    for (std::size_t i = 0; i < m_entries.size(); i++)
+    {
+        m_entries[i].player = &playerList[i]->getRecord();
+        const auto id = playerList[i]->getId();
+        if (id >= 0)
+        {
+            if (static_cast<std::size_t>(id) >= m_indexById.size())
+                m_indexById.resize(id + 1, -1);
+            m_indexById[id] = static_cast<std::int32_t>(i);
+        }
+        connect(playerList[i].get(), &Player::resultsChanged, this, &LiveStandings::markDirty);
+        markIndexDirty(i);
+    }
+}
+
+std::size_t LiveStandings::refresh()
+{
+    if (m_dirtyList.empty())
+        return 0;
+
+    //a changed player's own scores come first, since everyone's opponent percentages read them
+    //m_dirty is reused to mark the entries already queued for updateOpponentScores
+    std::vector<std::size_t> update = m_dirtyList;
+    for (auto index : m_dirtyList)
+    {
+        for (auto dependent : m_dependents[index])
+        {
+            if (!m_dirty[dependent])
+            {
+                m_dirty[dependent] = true;
+                update.push_back(dependent);
+            }
+        }
+        updateScores(index);
+    }
+    m_dirtyList.clear();
+
+    for (auto index : update)
+    {
+        updateOpponentScores(index);
+        m_dirty[index] = false;
+    }
+
+    return update.size();
+}
+
+std::vector<StandingsEntry> LiveStandings::getTop(std::size_t count) const
+{
+    std::vector<StandingsEntry> top;
+    const auto indices = m_ranking.top(count);
+    top.reserve(indices.size());
+    for (std::size_t i = 0; i < indices.size(); i++)
+    {
+        top.push_back(m_entries[indices[i]]);
+        if (i > 0 && top[i].key == top[i - 1].key)
+            top[i].place = top[i - 1].place;
+        else
+            top[i].place = static_cast<std::int32_t>(i + 1);
+    }
+    return top;
+}
+
+void LiveStandings::markDirty(Player *player)
+{
+    const auto index = indexOf(player->getId());
+    if (index >= 0 && m_players[index].get() == player)
+        markIndexDirty(index);
+}
+
+void LiveStandings::markIndexDirty(std::size_t index)
+{
+    if (m_dirty[index])
+        return;
+    m_dirty[index] = true;
+    m_dirtyList.push_back(index);
+}
+
+void LiveStandings::updateScores(std::size_t index)
+{
+    auto &entry = m_entries[index];
+    const auto &player = *entry.player;
+    entry.matchScore = player.getMatchScore();
+    entry.gameScore = player.getGameScore();
+    entry.matchWinPercentage = player.getMatchWinPercentage();
+    entry.gameWinPercentage = player.getGameWinPercentage();
+
+    for (auto opponent : m_opponents[index])
+    {
+        auto &dependents = m_dependents[opponent];
+        dependents.erase(std::find(dependents.begin(), dependents.end(), index));
+    }
+    m_opponents[index].clear();
+    for (const auto &result : player.getMatchResults())
+    {
+        if (!result.played() || result.bye())
+            continue;
+        const auto oppIndex = indexOf(result.opponent());
+        if (oppIndex < 0)
+            continue;
+        m_opponents[index].push_back(oppIndex);
+        m_dependents[oppIndex].push_back(index);
+    }
+}
+
+void LiveStandings::updateOpponentScores(std::size_t index)
+{
+    auto &entry = m_entries[index];
+
+    //players dropped from the list are asked directly
+    const auto opponents = averageOpponents(entry.player->getMatchResults(), -1, [this, index](const PackedMatchResult &result, double &matchWinPer, double &gameWinPer)
+                                            {
+                                                const auto oppIndex = indexOf(result.opponent());
+                                                if (oppIndex >= 0)
+                                                {
+                                                    matchWinPer = m_entries[oppIndex].matchWinPercentage;
+                                                    gameWinPer = m_entries[oppIndex].gameWinPercentage;
+                                                    return true;
+                                                }
+                                                const auto dropped = m_players[index]->getOpponent(result);
+                                                if (dropped == nullptr)
+                                                    return false;
+                                                matchWinPer = dropped->getMatchWinPercentage();
+                                                gameWinPer = dropped->getGameWinPercentage();
+                                                return true;
+                                            });
+    entry.opponentMatchWinPercentage = opponents.matchWinPercentage;
+    entry.opponentGameWinPercentage = opponents.gameWinPercentage;
+
+    entry.key = TiebreakKey(entry.matchScore, entry.gameScore, entry.matchWinPercentage, entry.gameWinPercentage,
+                            entry.opponentMatchWinPercentage, entry.opponentGameWinPercentage);
+    m_ranking.update(index, entry.key);
+}
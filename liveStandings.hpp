@@ -0,0 +1,95 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <QObject>
+#include <QList>
+#include "player.hpp"
+#include "standings.hpp"
+#include "standingsTree.hpp"
+
+#include <memory>
+#include <vector>
+
+//Standings kept up to date while results are entered and corrected.
+//Every player's scores and win percentages are cached. A player whose results change (Player::resultsChanged)
+//is marked dirty, and refresh recomputes the dirty players plus the opponent percentages of everyone who
+//played against them, so a correction costs time proportional to the players around it instead of the whole field.
+//Keys use the MtgTiebreaks order. Entries are also kept ranked in a StandingsTree,
+//so the leaders can be read after every result without sorting the field.
+class LiveStandings : public QObject
+{
+    Q_OBJECT
+
+public:
+    LiveStandings() : QObject() {}
+
+    ~LiveStandings() = default;
+
+    //starts tracking playerList, everyone is computed on the next refresh
+    void setPlayers(const QList<std::shared_ptr<Player>> &playerList);
+
+    //recomputes whatever changed since the last refresh, returns the number of entries recomputed
+    std::size_t refresh();
+
+    //one entry per player in player list order, as of the last refresh (places are not set)
+    inline const std::vector<StandingsEntry> &getEntries() const
+    {
+        return m_entries;
+    }
+
+    //the best count entries as of the last refresh, best first and with places set (equal keys share a place)
+    std::vector<StandingsEntry> getTop(std::size_t count) const;
+
+public slots:
+    void markDirty(Player *player);
+
+private:
+    void markIndexDirty(std::size_t index);
+
+    //entry of a player id, -1 if not tracked
+    inline std::int32_t indexOf(std::int32_t id) const
+    {
+        if (id < 0 || static_cast<std::size_t>(id) >= m_indexById.size())
+            return -1;
+        return m_indexById[id];
+    }
+
+    //recomputes the scores and win percentages of an entry, and updates the opponents recorded for it
+    void updateScores(std::size_t index);
+
+    //recomputes the opponent percentages and key of an entry, needs the opponents' scores to be up to date
+    void updateOpponentScores(std::size_t index);
+
+    QList<std::shared_ptr<Player>> m_players; //tracked players, in entry order
+    std::vector<StandingsEntry> m_entries;
+    std::vector<std::int32_t> m_indexById; //entry of each player id, -1 for players not tracked
+    std::vector<std::vector<std::size_t>> m_opponents;  //entries each entry was paired against at its last update
+    std::vector<std::vector<std::size_t>> m_dependents; //the reverse of m_opponents, entries whose opponent percentages use an entry
+    StandingsTree m_ranking;
+    std::vector<bool> m_dirty;
+    std::vector<std::size_t> m_dirtyList;
+};
@@ -25,10 +25,30 @@
 #include <iostream>
 
 #include "match.hpp"
+#include "fieldPairing.hpp"
+#include "playerIndex.hpp"
+#include "playerTable.hpp"
+#include "tiebreaks.hpp"
 #include <algorithm>
+#include <cstdlib>
+#include <unordered_set>
 #include <QMessageBox>
+#include <QSignalBlocker>
 #include <QLocale>
 
+namespace
+{
+//the records the core pairing engines work on, in list order
+std::vector<const PlayerRecord *> records(const QList<std::shared_ptr<Player>> &playerList)
+{
+    std::vector<const PlayerRecord *> players;
+    players.reserve(playerList.size());
+    for (const auto &player : playerList)
+        players.push_back(&player->getRecord());
+    return players;
+}
+} // namespace
+
 #define BYE_PLAYER_ID 10
 
 constexpr const char* P_ONE_LBL = "player_one";
@@ -81,16 +101,11 @@ void Match::setEnabled(bool enable)
 void Match::generateMatch(const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum)
 {
     m_matchups.clear();
+    m_pairingCache.reset();
     //generate pairings
-    auto sourceList = playerList;
-    decltype(sourceList) editedList;
-    while (!sourceList.empty())
-    {
-        std::uniform_int_distribution<std::size_t> dis(0, sourceList.size() - 1);
-        auto index = dis(m_reng);
-        editedList.push_back(sourceList[index]);
-        sourceList.removeAt(index);
-    }
+    auto reng = pairingEngine(m_seed, matchNum);
+    auto editedList = playerList;
+    shuffleField(editedList, reng);
     if (matchNum == 0)
     {
         for (int i = 0; i < editedList.size(); i += 2)
@@ -103,28 +118,22 @@ void Match::generateMatch(const QList<std::shared_ptr<Player>> &playerList, std:
     }
     else
     {
-        int b = 0;
-        int m = 0;
-        std::sort(editedList.begin(), editedList.end(), [match = (matchNum - 1)](std::shared_ptr<Player> p1, std::shared_ptr<Player> p2)
-                  { return p1->getMatchScore(match) > p2->getMatchScore(match); }); //use > for reverse sort
-        while (!generatePairing(editedList, matchNum - 1, b, m) && b <= matchNum && m <= matchNum)
-        {
-            m_matchups.clear();
-            m++;
-            if (m > matchNum)
-            {
-                m = 0;
-                b++;
-            }
-        }
-        if (b > matchNum && m > matchNum)
-        {
+        //stable, so players with the same score keep the shuffled order on every standard library
+        std::stable_sort(editedList.begin(), editedList.end(), [match = (matchNum - 1)](const std::shared_ptr<Player> &p1, const std::shared_ptr<Player> &p2)
+                         { return p1->getMatchScore(match) > p2->getMatchScore(match); }); //use > for reverse sort
+        bool paired = false;
+        if (m_pairingMethod == PairingMethod::WeightedMatching)
+            paired = generateWeightedPairing(editedList, matchNum - 1);
+        else if (m_pairingMethod == PairingMethod::ScoreBrackets)
+            paired = generateBracketPairing(editedList, matchNum - 1);
+        else if (m_pairingMethod == PairingMethod::TimeLimited)
+            paired = generateTimedPairing(editedList, matchNum - 1);
+        else
+            paired = generatePairing(editedList, matchNum - 1);
 
-            QLocale locale;
-            QMessageBox dialog;
-            dialog.setWindowTitle(tr("Match ") + locale.toString(matchNum) + tr(" generation error."));
-            dialog.setText(tr("Could not generate pairings for match"));
-            dialog.exec();
+        if (!paired)
+        {
+            showPairingError(matchNum);
             return;
         }
     }
@@ -132,7 +141,7 @@ void Match::generateMatch(const QList<std::shared_ptr<Player>> &playerList, std:
     updateMatchView();
 }
 
-bool Match::loadMatch(const nlohmann::json& j, const QList<std::shared_ptr<Player>>& players, std::size_t matchNum)
+bool Match::loadMatch(const nlohmann::json& j, const PlayerIndex& index, std::size_t matchNum)
 {
     if (!j.is_array())
     {
@@ -147,23 +156,10 @@ bool Match::loadMatch(const nlohmann::json& j, const QList<std::shared_ptr<Playe
         {
             return false;
         }
-        const auto p1Name = p[P_ONE_LBL].get<std::string>();
-        const auto p2Name = p.contains(P_TWO_LBL) ? p[P_TWO_LBL].get<std::string>() : "";
 
-        // find the player whose name matches
-        std::shared_ptr<Player> p1 = nullptr;
-        std::shared_ptr<Player> p2 = nullptr;
-        for (const auto& player : players)
-        {
-            if (player->getName() == QString::fromStdString(p1Name))
-            {
-                p1 = player;
-            }
-            else if (player->getName() == QString::fromStdString(p2Name))
-            {
-                p2 = player;
-            }
-        }
+        // find the players by name, no second player is a bye
+        const auto p1 = index.find(p[P_ONE_LBL].get<std::string>());
+        const auto p2 = p.contains(P_TWO_LBL) ? index.find(p[P_TWO_LBL].get<std::string>()) : nullptr;
 
         if (p1 == nullptr)
         {
@@ -185,46 +181,274 @@ bool Match::checkMatchValid(std::int32_t numPlayers)
     return m_matchups.size() >= ((numPlayers / 2) + (numPlayers % 2));
 }
 
-bool Match::finalizeMatch(const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum)
+bool Match::finalizeMatch(const PlayerTable &table, const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum)
 {
     if (!checkMatchValid(playerList.size()))
         return false;
 
     for (int i = 0; i < m_matchups.size(); i++)
     {
-        MatchResult res;
-        res.bye = m_matchups[i].p2 == nullptr;
-        res.opponent = m_matchups[i].p2;
-        res.wins = m_matchView->item(i, 2)->text().toInt();
-        res.losses = m_matchView->item(i, 3)->text().toInt();
-        res.ties = m_matchView->item(i, 4)->text().toInt();
-        res.matchWin = res.wins > res.losses;
-        res.matchTie = res.wins == res.losses;
-        m_matchups[i].p1->setMatchResults(matchNum, res);
-
-        if (!res.bye)
+        setRowResult(i, matchNum);
+    }
+
+    const auto &results = table.getResults();
+    const auto maxRound = std::min(matchNum, results.getNumRounds() - 1);
+    for (std::int32_t round = 0; round <= maxRound && !playerList.isEmpty(); round++)
+    {
+        //every player plays the same format
+        const auto bestOf = playerList.front()->getScoringRules().bestOf;
+        std::size_t id = 0;
+        const auto error = results.checkRound(round, bestOf, &id);
+        if (error == RoundError::None)
+            continue;
+
+        QLocale locale;
+        QString reason = tr("Match ") + locale.toString(round);
+        if (error == RoundError::NoOpponent)
+            reason += tr(" marked as played, but no opponent was set.");
+        else if (error == RoundError::OpponentMismatch)
+            reason += tr(" has an opponent who didn't play them.");
+        else if (error == RoundError::TooManyGames)
+            reason += tr(" has a total of more than ") + locale.toString(bestOf) + tr(" wins or losses.");
+        else
+            reason += tr(" has different games than their opponent.");
+
+        //only players in the table have results in its matrix
+        QMessageBox dialog;
+        dialog.setWindowTitle(tr("Match ") + locale.toString(matchNum) + tr(" error."));
+        dialog.setText(table.get(id)->getName() + tr(": ") + reason);
+        dialog.exec();
+        return false;
+    }
+
+    captureStandings(table, playerList, matchNum);
+
+    m_matchView->resizeColumnsToContents();
+    return true;
+}
+
+void Match::captureStandings(const PlayerTable &table, const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum)
+{
+    //dropped players are only in the table, but still count as opponents
+    const auto players = records(playerList);
+    const auto playersById = table.getRecords();
+    Standings standings;
+    if (m_tiebreakRules == TiebreakRules::Chess)
+        standings.calculate<ChessTiebreaks>(players, playersById, matchNum);
+    else
+        standings.calculate<MtgTiebreaks>(players, playersById, matchNum);
+    m_standings = std::make_shared<const StandingsSnapshot>(standings, matchNum);
+}
+
+bool Match::commitResult(std::int32_t row, std::int32_t matchNum)
+{
+    if (row < 0 || row >= m_matchups.size() || m_matchups[row].p2 == nullptr || !rowComplete(row))
+        return false;
+
+    setRowResult(row, matchNum);
+    return true;
+}
+
+bool Match::isComplete() const
+{
+    for (int row = 0; row < m_matchups.size(); row++)
+    {
+        if (m_matchups[row].p2 != nullptr && !rowComplete(row))
+            return false;
+    }
+    return isGenerated();
+}
+
+bool Match::rowComplete(std::int32_t row) const
+{
+    for (int column = 2; column < 5; column++)
+    {
+        auto item = m_matchView->item(row, column);
+        bool ok = false;
+        if (item == nullptr)
+            return false;
+        item->text().toInt(&ok);
+        if (!ok)
+            return false;
+    }
+    return true;
+}
+
+bool Match::hasResults() const
+{
+    for (int row = 0; row < m_matchups.size(); row++)
+    {
+        if (m_matchups[row].p2 == nullptr) //the bye fills in its own result
+            continue;
+        for (int column = 2; column < 5; column++)
         {
-            std::swap(res.wins, res.losses);
-            res.opponent = m_matchups[i].p1;
-            res.matchWin = !res.matchWin && !res.matchTie;
-            m_matchups[i].p2->setMatchResults(matchNum, res);
+            const auto item = m_matchView->item(row, column);
+            if (item != nullptr && !item->text().trimmed().isEmpty())
+                return true;
         }
     }
+    return false;
+}
+
+bool Match::repairMatch(const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum)
+{
+    if (m_matchups.empty())
+        return false;
+    m_pairingCache.reset();
+    QSignalBlocker blocker(m_matchView); //rows are moved and refilled, nothing is being entered
+
+    std::unordered_set<const Player *> listed;
+    for (const auto &player : playerList)
+        listed.insert(player.get());
+
+    //break up every matchup that lost a player, and the bye
+    std::unordered_set<const Player *> placed;
+    QList<std::shared_ptr<Player>> loose;
+    std::vector<std::int32_t> freeRows;
+    std::vector<bool> freed(m_matchups.size(), false);
+    for (std::int32_t i = 0; i < m_matchups.size(); i++)
+    {
+        const auto &matchup = m_matchups[i];
+        const bool keep1 = listed.count(matchup.p1.get()) > 0;
+        const bool keep2 = matchup.p2 != nullptr && listed.count(matchup.p2.get()) > 0;
+        if (keep1)
+            placed.insert(matchup.p1.get());
+        if (keep2)
+            placed.insert(matchup.p2.get());
+        if (keep1 && keep2)
+            continue;
+        if (keep1)
+            loose.push_back(matchup.p1);
+        if (keep2)
+            loose.push_back(matchup.p2);
+        freeRows.push_back(i);
+        freed[i] = true;
+    }
 
+    //late additions
     for (const auto &player : playerList)
     {
-        QString reason;
-        if (!player->scoresValid(&reason, matchNum))
+        if (placed.count(player.get()) == 0)
+            loose.push_back(player);
+    }
+
+    const auto scoreMatch = matchNum - 1;
+    QList<Matchup> repaired;
+    while (!loose.empty())
+    {
+        repaired.clear();
+        if (matchNum == 0)
         {
-            QLocale locale;
-            QMessageBox dialog;
-            dialog.setWindowTitle(tr("Match ") + locale.toString(matchNum) + tr(" error."));
-            dialog.setText(player->getName() + tr(": ") + reason);
-            dialog.exec();
-            return false;
+            //nothing to avoid yet, pair in order like generateMatch
+            for (int i = 0; i < loose.size(); i += 2)
+                repaired.emplace_back(Matchup{loose[i], i + 1 < loose.size() ? loose[i + 1] : nullptr});
+            break;
+        }
+
+        std::stable_sort(loose.begin(), loose.end(), [scoreMatch](const std::shared_ptr<Player> &p1, const std::shared_ptr<Player> &p2)
+                         { return p1->getMatchScore(scoreMatch) > p2->getMatchScore(scoreMatch); });
+        const auto players = records(loose);
+        PairingSearch search(players, scoreMatch, &m_pairingCache);
+        const bool found = search.run();
+        for (const auto &pair : search.getPairs())
+            repaired.emplace_back(Matchup{loose[pair.first], pair.second >= 0 ? loose[pair.second] : nullptr});
+        if (found && search.getCost() == 0)
+            break;
+
+        //no free pairing, pull in the untouched matchup closest in score to the loose players and try again
+        std::int32_t closest = -1;
+        std::int64_t closestDiff = INT64_MAX;
+        for (std::int32_t i = 0; i < m_matchups.size(); i++)
+        {
+            if (freed[i])
+                continue;
+            const std::int64_t score = m_matchups[i].p1->getMatchScore(scoreMatch);
+            for (const auto &player : loose)
+            {
+                const auto diff = std::abs(score - static_cast<std::int64_t>(player->getMatchScore(scoreMatch)));
+                if (diff < closestDiff)
+                {
+                    closestDiff = diff;
+                    closest = i;
+                }
+            }
+        }
+        if (closest < 0) //everything is already loose, take the best there is
+        {
+            if (!found)
+            {
+                showPairingError(matchNum + 1);
+                return false;
+            }
+            break;
+        }
+        loose.push_back(m_matchups[closest].p1);
+        loose.push_back(m_matchups[closest].p2);
+        freeRows.insert(std::lower_bound(freeRows.begin(), freeRows.end(), closest), closest);
+        freed[closest] = true;
+    }
+
+    //results committed for the broken matchups no longer stand, the new rows start out empty
+    for (const auto &matchup : repaired)
+    {
+        matchup.p1->setMatchPlayed(matchNum, false);
+        if (matchup.p2 != nullptr)
+            matchup.p2->setMatchPlayed(matchNum, false);
+    }
+
+    //new pairs go on the freed rows, extra pairs and the bye go at the end
+    std::vector<bool> fresh(m_matchups.size(), false); //rows that have to be written to the table
+    std::size_t nextRow = 0;
+    Matchup bye{nullptr, nullptr};
+    for (const auto &matchup : repaired)
+    {
+        if (matchup.p2 == nullptr)
+        {
+            bye = matchup;
+        }
+        else if (nextRow < freeRows.size())
+        {
+            m_matchups[freeRows[nextRow]] = matchup;
+            fresh[freeRows[nextRow++]] = true;
+        }
+        else
+        {
+            m_matchups.push_back(matchup);
+            fresh.push_back(true);
+        }
+    }
+    if (bye.p1 != nullptr)
+    {
+        m_matchups.push_back(bye);
+        fresh.push_back(true);
+    }
+    m_matchView->setRowCount(std::max<int>(m_matchView->rowCount(), m_matchups.size()));
+
+    //fill the rows left over with the last row, so the other tables keep their number
+    for (auto i = freeRows.size(); i-- > nextRow;)
+    {
+        const auto row = freeRows[i];
+        const auto last = m_matchups.size() - 1;
+        if (row != last)
+        {
+            m_matchups[row] = m_matchups[last];
+            fresh[row] = fresh[last];
+            if (!fresh[row]) //keep any results already entered
+            {
+                for (int column = 0; column < 5; column++)
+                    m_matchView->setItem(row, column, m_matchView->takeItem(last, column));
+            }
         }
+        m_matchups.removeLast();
+        fresh.pop_back();
     }
 
+    m_matchView->setRowCount(m_matchups.size());
+    for (std::int32_t i = 0; i < m_matchups.size(); i++)
+    {
+        if (fresh[i])
+            updateMatchRow(i);
+    }
     m_matchView->resizeColumnsToContents();
     return true;
 }
@@ -232,97 +456,173 @@ bool Match::finalizeMatch(const QList<std::shared_ptr<Player>> &playerList, std:
 void Match::reset()
 {
     m_matchups.clear();
+    m_standings = nullptr;
     updateMatchView();
 }
 
-bool Match::generatePairing(const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum, std::int32_t maxByes, std::int32_t maxMatchups)
+bool Match::generatePairing(const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum, std::uint64_t maxCost)
 {
-    if (playerList.empty())
+    const auto players = records(playerList);
+    PairingSearch search(players, matchNum, &m_pairingCache);
+    if (!search.runParallel(maxCost, m_pairingThreads, m_deterministicPairing))
         return false;
-    auto pairList = playerList;
-    auto p1 = pairList[0];
-    pairList.removeFirst();
-    for (const auto &p2 : pairList)
+    addMatchups(playerList, search.getPairs());
+    return true;
+}
+
+bool Match::generateTimedPairing(const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum)
+{
+    const auto players = records(playerList);
+    PairingSearch search(players, matchNum, &m_pairingCache);
+    search.setFloatCost(PAIRING_FLOAT_COST);
+    //the last quarter of the budget is kept for the weighted matching fallback
+    const auto budget = std::chrono::duration_cast<std::chrono::milliseconds>(m_pairingTimeLimit);
+    search.setDeadline(std::chrono::steady_clock::now() + budget * 3 / 4);
+    if (!search.runParallel(PAIRING_NO_COST_LIMIT, m_pairingThreads, m_deterministicPairing))
     {
-        if (p1->getPreviousOpponents(matchNum).count(p2->getId()) > maxMatchups || p2->getPreviousOpponents(matchNum).count(p1->getId()) > maxMatchups) //already played too many times
-            continue;
-        if (pairList.size() == 1) //only one player left, and it's valid. return true
-        {
-            m_matchups.push_front(Matchup{p1, p2});
-            return true;
-        }
-        auto remaining = pairList;
-        remaining.removeOne(p2);
-        if (generatePairing(remaining, matchNum, maxByes, maxMatchups))
-        {
-            m_matchups.push_front(Matchup{p1, p2});
-            return true;
-        }
+        //nothing found in time, the weighted matching is polynomial and always pairs everyone
+        return generateWeightedPairing(playerList, matchNum);
     }
-    if ((pairList.size() & 1) == 0) //if no pairs found for current player, and there is an even number of other players
+    //if the search timed out this is the best pairing it found
+    addMatchups(playerList, search.getPairs());
+    return true;
+}
+
+bool Match::generateBracketPairing(const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum)
+{
+    std::vector<std::pair<std::int32_t, std::int32_t>> pairs;
+    if (!bracketPairing(records(playerList), matchNum, &m_pairingCache, m_pairingThreads, m_deterministicPairing, pairs))
+        return false;
+    addMatchups(playerList, pairs);
+    return true;
+}
+
+void Match::addMatchups(const QList<std::shared_ptr<Player>> &playerList, const std::vector<std::pair<std::int32_t, std::int32_t>> &pairs)
+{
+    for (const auto &pair : pairs)
+        m_matchups.emplace_back(Matchup{playerList[pair.first], pair.second >= 0 ? playerList[pair.second] : nullptr});
+}
+
+bool Match::generateWeightedPairing(const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum)
+{
+    std::vector<std::int64_t> scores;
+    std::vector<std::int64_t> byes;
+    scores.reserve(playerList.size());
+    byes.reserve(playerList.size());
+    for (const auto &p : playerList)
     {
-        if (p1->receivedByes(matchNum) > maxByes)
-            return false;
-        if (generatePairing(pairList, matchNum, maxByes, maxMatchups))
-        {
-            m_matchups.push_front(Matchup{p1, nullptr});
-            return true;
-        }
+        scores.push_back(p->getMatchScore(matchNum));
+        byes.push_back(p->receivedByes(matchNum));
+    }
+
+    const auto mates = weightedPairing(scores, byes, [&playerList, matchNum](std::int32_t i, std::int32_t j)
+                                       { return playerList[i]->timesPlayed(playerList[j]->getId(), matchNum); });
+    if (mates.empty())
+        return false;
+
+    const auto numPlayers = static_cast<std::int32_t>(playerList.size());
+    std::int32_t byePlayer = -1;
+    for (std::int32_t i = 0; i < numPlayers; i++)
+    {
+        if (mates[i] == numPlayers)
+            byePlayer = i;
+        else if (mates[i] > i)
+            m_matchups.emplace_back(Matchup{playerList[i], playerList[mates[i]]});
+    }
+    if (byePlayer >= 0)
+        m_matchups.emplace_back(Matchup{playerList[byePlayer], nullptr});
+    return true;
+}
+
+void Match::showPairingError(std::int32_t matchNum)
+{
+    QLocale locale;
+    QMessageBox dialog;
+    dialog.setWindowTitle(tr("Match ") + locale.toString(matchNum) + tr(" generation error."));
+    dialog.setText(tr("Could not generate pairings for match"));
+    dialog.exec();
+}
+
+void Match::setRowResult(std::int32_t row, std::int32_t matchNum)
+{
+    MatchResult res;
+    res.bye = m_matchups[row].p2 == nullptr;
+    res.opponent = res.bye ? -1 : m_matchups[row].p2->getId();
+    res.wins = m_matchView->item(row, 2)->text().toInt();
+    res.losses = m_matchView->item(row, 3)->text().toInt();
+    res.ties = m_matchView->item(row, 4)->text().toInt();
+    res.matchWin = res.wins > res.losses;
+    res.matchTie = res.wins == res.losses;
+    m_matchups[row].p1->setMatchResults(matchNum, res);
+
+    if (!res.bye)
+    {
+        std::swap(res.wins, res.losses);
+        res.opponent = m_matchups[row].p1->getId();
+        res.matchWin = !res.matchWin && !res.matchTie;
+        m_matchups[row].p2->setMatchResults(matchNum, res);
     }
-    return false;
 }
 
 void Match::updateMatchView()
 {
+    QSignalBlocker blocker(m_matchView); //filling the table isn't entering results
     m_matchView->setRowCount(m_matchups.size());
 
     //write pairings to table
     for (int i = 0; i < m_matchups.size(); i++)
     {
-        if (m_matchups[i].p1 != nullptr) //should never fail, but...
-        {
-            auto item = new QTableWidgetItem(m_matchups[i].p1->getName());
-            item->setFlags(item->flags() & ~Qt::ItemIsEditable);
-            m_matchView->setItem(i, 0, item);
-        }
-        if (m_matchups[i].p2 != nullptr)
-        {
-            auto item = new QTableWidgetItem(m_matchups[i].p2->getName());
-            item->setFlags(item->flags() & ~Qt::ItemIsEditable);
-            m_matchView->setItem(i, 1, item);
-            item = new QTableWidgetItem(tr(""));
-            item->setFlags(item->flags() | Qt::ItemIsEditable);
-            m_matchView->setItem(i, 2, item);
-            item = new QTableWidgetItem(tr(""));
-            item->setFlags(item->flags() | Qt::ItemIsEditable);
-            m_matchView->setItem(i, 3, item);
-            item = new QTableWidgetItem(tr(""));
-            item->setFlags(item->flags() | Qt::ItemIsEditable);
-            m_matchView->setItem(i, 4, item);
-        }
-        else
-        {
-            auto item = new QTableWidgetItem(tr("Bye"));
-            item->setFlags(item->flags() & ~Qt::ItemIsEditable);
-            m_matchView->setItem(i, 1, item);
-            //fill in the bye info
-            item = new QTableWidgetItem(tr("2"));
-            item->setFlags(item->flags() & ~Qt::ItemIsEditable);
-            m_matchView->setItem(i, 2, item);
-            item = new QTableWidgetItem(tr("0"));
-            item->setFlags(item->flags() & ~Qt::ItemIsEditable);
-            m_matchView->setItem(i, 3, item);
-            item = new QTableWidgetItem(tr("0"));
-            item->setFlags(item->flags() & ~Qt::ItemIsEditable);
-            m_matchView->setItem(i, 4, item);
-        }
+        updateMatchRow(i);
     }
 
     m_matchView->resizeColumnsToContents();
 }
 
+void Match::updateMatchRow(std::int32_t row)
+{
+    const auto &matchup = m_matchups[row];
+    if (matchup.p1 != nullptr) //should never fail, but...
+    {
+        auto item = new QTableWidgetItem(matchup.p1->getName());
+        item->setFlags(item->flags() & ~Qt::ItemIsEditable);
+        m_matchView->setItem(row, 0, item);
+    }
+    if (matchup.p2 != nullptr)
+    {
+        auto item = new QTableWidgetItem(matchup.p2->getName());
+        item->setFlags(item->flags() & ~Qt::ItemIsEditable);
+        m_matchView->setItem(row, 1, item);
+        item = new QTableWidgetItem(tr(""));
+        item->setFlags(item->flags() | Qt::ItemIsEditable);
+        m_matchView->setItem(row, 2, item);
+        item = new QTableWidgetItem(tr(""));
+        item->setFlags(item->flags() | Qt::ItemIsEditable);
+        m_matchView->setItem(row, 3, item);
+        item = new QTableWidgetItem(tr(""));
+        item->setFlags(item->flags() | Qt::ItemIsEditable);
+        m_matchView->setItem(row, 4, item);
+    }
+    else
+    {
+        auto item = new QTableWidgetItem(tr("Bye"));
+        item->setFlags(item->flags() & ~Qt::ItemIsEditable);
+        m_matchView->setItem(row, 1, item);
+        //fill in the bye info
+        item = new QTableWidgetItem(tr("2"));
+        item->setFlags(item->flags() & ~Qt::ItemIsEditable);
+        m_matchView->setItem(row, 2, item);
+        item = new QTableWidgetItem(tr("0"));
+        item->setFlags(item->flags() & ~Qt::ItemIsEditable);
+        m_matchView->setItem(row, 3, item);
+        item = new QTableWidgetItem(tr("0"));
+        item->setFlags(item->flags() & ~Qt::ItemIsEditable);
+        m_matchView->setItem(row, 4, item);
+    }
+}
+
 void Match::updateMatchResultsView(std::size_t matchNum)
 {
+    QSignalBlocker blocker(m_matchView);
     for (int i = 0; i < m_matchups.size(); i++)
     {
         const auto& p1 = m_matchups[i].p1;
@@ -28,16 +28,36 @@
 #include <QPushButton>
 #include <QTableWidget>
 #include "player.hpp"
-#include <random>
+#include "pairingCache.hpp"
+#include "pairingSearch.hpp"
+#include "standings.hpp"
+#include <algorithm>
+#include <chrono>
 
 #include "json.hpp"
 
+class PlayerTable;
+
 struct Matchup
 {
     std::shared_ptr<Player> p1;
     std::shared_ptr<Player> p2;
 };
 
+enum class PairingMethod
+{
+    Backtracking,     //branch and bound search for the lowest cost pairing, see generatePairing
+    WeightedMatching, //maximum weight matching on a compatibility graph, see generateWeightedPairing
+    ScoreBrackets,    //backtracking within each score group using floaters, see generateBracketPairing
+    TimeLimited,      //best pairing the search finds within a time budget, see generateTimedPairing
+};
+
+enum class TiebreakRules
+{
+    Mtg,   //MWP, GWP, OMWP and OGWP, see MtgTiebreaks
+    Chess, //Buchholz, Sonneborn-Berger and progressive score, see ChessTiebreaks
+};
+
 class Match : public QObject
 {
     Q_OBJECT
@@ -45,7 +65,7 @@ class Match : public QObject
 public:
     Match() : QObject(){};
 
-    Match(QPushButton *generateMatchB, QTableWidget *matchView) : QObject(), m_rd(), m_reng(m_rd())
+    Match(QPushButton *generateMatchB, QTableWidget *matchView) : QObject()
     {
         m_generateMatchB = generateMatchB;
         m_matchView = matchView;
@@ -55,18 +75,32 @@ public:
         setupTables();
     };
 
-    Match(const Match &mch) : QObject(), m_rd(), m_reng(m_rd())
+    Match(const Match &mch) : QObject()
     {
         m_generateMatchB = mch.m_generateMatchB;
         m_matchView = mch.m_matchView;
         m_matchups = mch.m_matchups;
+        m_pairingMethod = mch.m_pairingMethod;
+        m_pairingThreads = mch.m_pairingThreads;
+        m_deterministicPairing = mch.m_deterministicPairing;
+        m_pairingTimeLimit = mch.m_pairingTimeLimit;
+        m_tiebreakRules = mch.m_tiebreakRules;
+        m_seed = mch.m_seed;
+        m_standings = mch.m_standings;
     }
 
-    Match(Match &&mch) : QObject(), m_rd(), m_reng(m_rd())
+    Match(Match &&mch) : QObject()
     {
         m_generateMatchB = mch.m_generateMatchB;
         m_matchView = mch.m_matchView;
         m_matchups = std::move(mch.m_matchups);
+        m_pairingMethod = mch.m_pairingMethod;
+        m_pairingThreads = mch.m_pairingThreads;
+        m_deterministicPairing = mch.m_deterministicPairing;
+        m_pairingTimeLimit = mch.m_pairingTimeLimit;
+        m_tiebreakRules = mch.m_tiebreakRules;
+        m_seed = mch.m_seed;
+        m_standings = std::move(mch.m_standings);
     }
 
     ~Match() = default;
@@ -76,6 +110,13 @@ public:
         m_generateMatchB = mch.m_generateMatchB;
         m_matchView = mch.m_matchView;
         m_matchups = mch.m_matchups;
+        m_pairingMethod = mch.m_pairingMethod;
+        m_pairingThreads = mch.m_pairingThreads;
+        m_deterministicPairing = mch.m_deterministicPairing;
+        m_pairingTimeLimit = mch.m_pairingTimeLimit;
+        m_tiebreakRules = mch.m_tiebreakRules;
+        m_seed = mch.m_seed;
+        m_standings = mch.m_standings;
         return *this;
     }
 
@@ -84,41 +125,172 @@ public:
         m_generateMatchB = mch.m_generateMatchB;
         m_matchView = mch.m_matchView;
         m_matchups = std::move(mch.m_matchups);
+        m_pairingMethod = mch.m_pairingMethod;
+        m_pairingThreads = mch.m_pairingThreads;
+        m_deterministicPairing = mch.m_deterministicPairing;
+        m_pairingTimeLimit = mch.m_pairingTimeLimit;
+        m_tiebreakRules = mch.m_tiebreakRules;
+        m_seed = mch.m_seed;
+        m_standings = std::move(mch.m_standings);
         return *this;
     }
 
     void setupTables();
 
     nlohmann::json toJson() const;
-    bool loadMatch(const nlohmann::json& j, const QList<std::shared_ptr<Player>>& playerList, std::size_t matchNum);
+    bool loadMatch(const nlohmann::json& j, const PlayerIndex& index, std::size_t matchNum);
 
     bool checkMatchValid(std::int32_t numPlayers);
 
+    inline PairingMethod getPairingMethod() const
+    {
+        return m_pairingMethod;
+    }
+
+    inline void setPairingMethod(PairingMethod method)
+    {
+        m_pairingMethod = method;
+    }
+
+    //number of threads the backtracking search may use, 1 searches on the calling thread
+    inline void setPairingThreads(std::int32_t numThreads)
+    {
+        m_pairingThreads = std::max(numThreads, 1);
+    }
+
+    //if set, parallel searches return the same pairing as a single threaded search
+    //otherwise the pairing depends on thread timing and can't be replayed from the seed
+    inline void setDeterministicPairing(bool deterministic)
+    {
+        m_deterministicPairing = deterministic;
+    }
+
+    //same seed, match number and previous results give the same pairings on every platform,
+    //unless the pairing depends on timing: non-deterministic parallel search, or a time limit that ran out
+    inline void setSeed(std::uint64_t seed)
+    {
+        m_seed = seed;
+    }
+
+    //tiebreaks ranking the standings captured by finalizeMatch
+    inline TiebreakRules getTiebreakRules() const
+    {
+        return m_tiebreakRules;
+    }
+
+    inline void setTiebreakRules(TiebreakRules rules)
+    {
+        m_tiebreakRules = rules;
+    }
+
+    //time budget for PairingMethod::TimeLimited, the search gets three quarters of it and the weighted matching
+    //fallback the rest. the matching can't be stopped part way, so on very large fields it may run past the budget
+    inline std::int32_t getPairingTimeLimit() const
+    {
+        return static_cast<std::int32_t>(m_pairingTimeLimit.count());
+    }
+
+    inline void setPairingTimeLimit(std::int32_t seconds)
+    {
+        m_pairingTimeLimit = std::chrono::seconds(std::max(seconds, 1));
+    }
+
+    inline bool isGenerated() const
+    {
+        return !m_matchups.empty();
+    }
+
+    //true once a result was typed on any row, the pairings are settled from then on
+    bool hasResults() const;
+
+    //true if every row but the bye holds a number for wins, losses and ties
+    bool isComplete() const;
+
+    //standings after this match, captured when the match is finalized or loaded complete, nullptr until then
+    inline std::shared_ptr<const StandingsSnapshot> getStandings() const
+    {
+        return m_standings;
+    }
+
 public slots:
     void setEnabled(bool enable);
 
     void generateMatch(const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum);
 
-    bool finalizeMatch(const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum);
+    //every match up to matchNum is checked round by round in the result matrix of table
+    bool finalizeMatch(const PlayerTable &table, const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum);
+
+    //ranks playerList after matchNum into the standings snapshot, without checking the results first
+    //snapshots aren't saved, so this rebuilds them when a tournament is loaded
+    void captureStandings(const PlayerTable &table, const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum);
+
+    //commit the result entered on a row to both players as soon as it's complete, so live standings follow along
+    //returns false for the bye row or while any of wins, losses and ties doesn't hold a number
+    bool commitResult(std::int32_t row, std::int32_t matchNum);
+
+    //fix up generated pairings after players dropped from or were added to playerList
+    //matchups of dropped players and the bye are broken up and their players paired with any new players,
+    //the rest of the matchups (and their results) stay on their rows unless needed to avoid rematches
+    //returns true if pairing found
+    bool repairMatch(const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum);
 
     void reset();
 
 private:
-    //recursively try pairings
+    //search for the lowest cost pairing, see PairingSearch
+    //requires player list to be sorted based on previous scores
+    //matchNum is max match to consider (usually the previous match)
+    //maxCost is the cost a pairing must stay below, previous byes and matchups add to the cost
+    //appends the pairings to m_matchups and returns true if pairing found
+    bool generatePairing(const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum, std::uint64_t maxCost = PAIRING_NO_COST_LIMIT);
+
+    //pair each score group on its own, see bracketPairing
+    //requires player list to be sorted based on previous scores
+    //matchNum is max match to consider (usually the previous match)
+    //returns true if pairing found
+    bool generateBracketPairing(const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum);
+
+    //appends the pairings found by a core pairing engine, indexes into playerList, to m_matchups
+    void addMatchups(const QList<std::shared_ptr<Player>> &playerList, const std::vector<std::pair<std::int32_t, std::int32_t>> &pairs);
+
+    //search for the lowest cost pairing, also counting score differences, until the time budget runs out
+    //requires player list to be sorted based on previous scores
+    //matchNum is max match to consider (usually the previous match)
+    //falls back to generateWeightedPairing if the search found nothing in time
+    //returns true if pairing found
+    bool generateTimedPairing(const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum);
+
+    //pair players with a maximum weight matching, penalizing repeated byes, rematches and score differences
     //requires player list to be sorted based on previous scores
     //matchNum is max match to consider (usually the previous match)
-    //maxByes is max previous byes per player for pairing attempt
-    //maxMatchups is max previous matchups per player for pairing attempt
     //returns true if pairing found
-    bool generatePairing(const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum, std::int32_t maxByes, std::int32_t maxMatchups);
+    bool generateWeightedPairing(const QList<std::shared_ptr<Player>> &playerList, std::int32_t matchNum);
+
+    void showPairingError(std::int32_t matchNum);
+
+    //set the result on a row for both players, read from the match view
+    void setRowResult(std::int32_t row, std::int32_t matchNum);
+
+    //true if wins, losses and ties of a row all hold a number
+    bool rowComplete(std::int32_t row) const;
+
     QPushButton *m_generateMatchB = nullptr;
     QTableWidget *m_matchView = nullptr;
 
     QList<Matchup> m_matchups;
 
-    std::random_device m_rd;
-    std::default_random_engine m_reng;
+    PairingMethod m_pairingMethod = PairingMethod::Backtracking;
+    std::int32_t m_pairingThreads = 1;
+    bool m_deterministicPairing = true;
+    std::chrono::seconds m_pairingTimeLimit{10};
+    TiebreakRules m_tiebreakRules = TiebreakRules::Mtg;
+    PairingCache m_pairingCache; //cost bounds for subsets of players seen by generatePairing, reset for each generateMatch
+
+    std::uint64_t m_seed = 0; //tournament seed, the shuffle for each match is derived from it
+
+    std::shared_ptr<const StandingsSnapshot> m_standings; //shared between copies, never modified once captured
 
     void updateMatchView();
+    void updateMatchRow(std::int32_t row);
     void updateMatchResultsView(std::size_t matchNum);
 };
@@ -0,0 +1,158 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+
+//one match from one player's side, see PackedMatchResult for the stored form
+struct MatchResult
+{
+    bool played = false; //set to true when this match has been played, even if it was a bye. Scores are ignored if false
+    bool matchWin = false;
+    bool matchTie = false;
+    bool bye = false;
+    std::uint32_t wins = 0;
+    std::uint32_t losses = 0;
+    std::uint32_t ties = 0;
+    std::int32_t opponent = -1; //id of the opponent, see PlayerTable and Tournament. -1 for a bye
+};
+
+//MatchResult packed into 8 bytes, the form results are stored in by PlayerRecord
+//flags in the low byte, then a byte each for wins, losses and ties (clamped to 255), then the opponent id
+class PackedMatchResult
+{
+public:
+    enum Flags : std::uint8_t
+    {
+        PLAYED = 1,
+        MATCH_WIN = 2,
+        MATCH_TIE = 4,
+        BYE = 8,
+    };
+
+    constexpr PackedMatchResult() = default;
+
+    explicit constexpr PackedMatchResult(const MatchResult &result)
+        : m_bits(flag(result.played, PLAYED) | flag(result.matchWin, MATCH_WIN) | flag(result.matchTie, MATCH_TIE) | flag(result.bye, BYE) |
+                 (clamp(result.wins) << WINS_SHIFT) | (clamp(result.losses) << LOSSES_SHIFT) | (clamp(result.ties) << TIES_SHIFT)),
+          m_opponent(result.opponent)
+    {
+    }
+
+    inline MatchResult unpack() const
+    {
+        MatchResult result;
+        result.played = played();
+        result.matchWin = matchWin();
+        result.matchTie = matchTie();
+        result.bye = bye();
+        result.wins = wins();
+        result.losses = losses();
+        result.ties = ties();
+        result.opponent = m_opponent;
+        return result;
+    }
+
+    constexpr std::uint8_t getFlags() const
+    {
+        return static_cast<std::uint8_t>(m_bits & 0xff);
+    }
+
+    constexpr bool played() const
+    {
+        return (m_bits & PLAYED) != 0;
+    }
+
+    constexpr bool matchWin() const
+    {
+        return (m_bits & MATCH_WIN) != 0;
+    }
+
+    constexpr bool matchTie() const
+    {
+        return (m_bits & MATCH_TIE) != 0;
+    }
+
+    constexpr bool bye() const
+    {
+        return (m_bits & BYE) != 0;
+    }
+
+    constexpr std::uint32_t wins() const
+    {
+        return (m_bits >> WINS_SHIFT) & 0xff;
+    }
+
+    constexpr std::uint32_t losses() const
+    {
+        return (m_bits >> LOSSES_SHIFT) & 0xff;
+    }
+
+    constexpr std::uint32_t ties() const
+    {
+        return (m_bits >> TIES_SHIFT) & 0xff;
+    }
+
+    constexpr std::uint32_t gamesPlayed() const
+    {
+        return wins() + losses() + ties();
+    }
+
+    constexpr std::int32_t opponent() const
+    {
+        return m_opponent;
+    }
+
+    inline void setPlayed(bool played)
+    {
+        m_bits = played ? (m_bits | PLAYED) : (m_bits & ~static_cast<std::uint32_t>(PLAYED));
+    }
+
+    inline void setOpponent(std::int32_t opponent)
+    {
+        m_opponent = opponent;
+    }
+
+private:
+    static constexpr std::uint32_t WINS_SHIFT = 8;
+    static constexpr std::uint32_t LOSSES_SHIFT = 16;
+    static constexpr std::uint32_t TIES_SHIFT = 24;
+
+    static constexpr std::uint32_t flag(bool set, Flags value)
+    {
+        return set ? static_cast<std::uint32_t>(value) : 0u;
+    }
+
+    static constexpr std::uint32_t clamp(std::uint32_t games)
+    {
+        return games < 255 ? games : 255;
+    }
+
+    std::uint32_t m_bits = 0;
+    std::int32_t m_opponent = -1;
+};
+
+static_assert(sizeof(PackedMatchResult) == 8, "PackedMatchResult should stay 8 bytes");
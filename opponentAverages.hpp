@@ -0,0 +1,70 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "matchResult.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+//average win percentages of the opponents a player met, the OMWP and OGWP tiebreakers
+struct OpponentAverages
+{
+    double matchWinPercentage = 0.0;
+    double gameWinPercentage = 0.0;
+    std::int32_t numOpponents = 0;
+};
+
+//Averages the opponents of one player's results, in match order, up to maxMatch (-1 for all matches).
+//results is indexed by match number, a result vector or a ResultMatrix::Column.
+//Byes and unplayed matches don't count, for every other result
+//    bool opponent(const PackedMatchResult &result, double &matchWinPercentage, double &gameWinPercentage)
+//gives the opponent's win percentages, or returns false for an opponent that can't be found, which isn't counted.
+//Every standings calculation averages through here, so they agree on the sums. No opponents averages to NaN.
+template <typename Results, typename Opponent>
+OpponentAverages averageOpponents(const Results &results, std::int32_t maxMatch, Opponent opponent)
+{
+    std::int32_t maxMatchNum = static_cast<std::int32_t>(results.size()) - 1;
+    if (maxMatch >= 0)
+        maxMatchNum = std::min(maxMatch, maxMatchNum);
+
+    OpponentAverages averages;
+    for (std::int32_t i = 0; i <= maxMatchNum; i++)
+    {
+        const auto &result = results[i];
+        if (!result.played() || result.bye())
+            continue;
+        double matchWinPer = 0.0;
+        double gameWinPer = 0.0;
+        if (!opponent(result, matchWinPer, gameWinPer))
+            continue;
+        averages.matchWinPercentage += matchWinPer;
+        averages.gameWinPercentage += gameWinPer;
+        averages.numOpponents++;
+    }
+    averages.matchWinPercentage /= static_cast<double>(averages.numOpponents);
+    averages.gameWinPercentage /= static_cast<double>(averages.numOpponents);
+    return averages;
+}
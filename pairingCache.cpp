@@ -0,0 +1,90 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pairingCache.hpp"
+
+#include <algorithm>
+
+namespace
+{
+//splitmix64 finalizer, spreads sequential ids over the whole key space
+std::uint64_t mix(std::uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+} // namespace
+
+void PairingCache::reset(std::uint32_t sizeBits)
+{
+    const auto size = std::uint64_t(1) << sizeBits;
+    if (m_size != size)
+    {
+        m_entries.reset(new Entry[size]);
+        m_size = size;
+    }
+    else
+    {
+        for (std::uint64_t i = 0; i < size; i++)
+        {
+            m_entries[i].check.store(0, std::memory_order_relaxed);
+            m_entries[i].bound.store(0, std::memory_order_relaxed);
+        }
+    }
+    m_mask = size - 1;
+    m_hits = 0;
+    m_misses = 0;
+}
+
+std::uint64_t PairingCache::lowerBound(std::uint64_t key) const
+{
+    if (m_size == 0)
+        return 0;
+    key = key == 0 ? 1 : key;
+    const auto &entry = m_entries[key & m_mask];
+    const auto bound = entry.bound.load(std::memory_order_relaxed);
+    if ((entry.check.load(std::memory_order_relaxed) ^ bound) == key)
+        return bound;
+    return 0;
+}
+
+void PairingCache::insert(std::uint64_t key, std::uint64_t bound)
+{
+    if (m_size == 0)
+        return;
+    key = key == 0 ? 1 : key;
+    auto &entry = m_entries[key & m_mask];
+    const auto oldBound = entry.bound.load(std::memory_order_relaxed);
+    if ((entry.check.load(std::memory_order_relaxed) ^ oldBound) == key)
+        bound = std::max(bound, oldBound);
+    entry.bound.store(bound, std::memory_order_relaxed);
+    entry.check.store(key ^ bound, std::memory_order_relaxed);
+}
+
+std::uint64_t PairingCache::playerKey(std::int32_t id)
+{
+    return mix(static_cast<std::uint64_t>(static_cast<std::uint32_t>(id)));
+}
@@ -0,0 +1,82 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+//Fixed size transposition table of lower bounds on the cost of pairing a set of players.
+//A set is identified by a 64 bit key made by XORing playerKey for every player in the set,
+//so keys can be built in any order. Entries are direct mapped and simply overwritten on collision.
+//Lookups and inserts may run on several threads at once, each entry stores key ^ bound next to the bound
+//so an entry torn by a concurrent insert reads as a miss.
+class PairingCache
+{
+public:
+    PairingCache() = default;
+
+    //allocates (if needed) and empties the table, 2^sizeBits entries
+    void reset(std::uint32_t sizeBits = 16);
+
+    //returns the recorded lower bound for key, or 0 if unknown
+    std::uint64_t lowerBound(std::uint64_t key) const;
+
+    //records that pairing the set costs at least bound
+    void insert(std::uint64_t key, std::uint64_t bound);
+
+    //lookups are counted by the caller and added once it's done, to keep the counters off the shared cache lines.
+    //A hit is a lookup whose bound cut off the set, a miss one that didn't
+    inline void addStats(std::uint64_t hits, std::uint64_t misses)
+    {
+        m_hits += hits;
+        m_misses += misses;
+    }
+
+    inline std::uint64_t hits() const
+    {
+        return m_hits;
+    }
+
+    inline std::uint64_t misses() const
+    {
+        return m_misses;
+    }
+
+    static std::uint64_t playerKey(std::int32_t id);
+
+private:
+    struct Entry
+    {
+        std::atomic<std::uint64_t> check{0}; //key ^ bound, 0 marks an empty entry
+        std::atomic<std::uint64_t> bound{0};
+    };
+
+    std::unique_ptr<Entry[]> m_entries;
+    std::uint64_t m_size = 0;
+    std::uint64_t m_mask = 0;
+    std::uint64_t m_hits = 0;
+    std::uint64_t m_misses = 0;
+};
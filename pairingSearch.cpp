@@ -0,0 +1,435 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pairingSearch.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <thread>
+
+constexpr std::int32_t PARALLEL_MIN_PLAYERS = 16; //smaller lists are searched on the calling thread
+
+namespace
+{
+//search the players of subset on their own, appending the pairings as indexes into players
+bool pairSubset(const std::vector<const PlayerRecord *> &players, const std::vector<std::int32_t> &subset, std::int32_t matchNum, PairingCache *cache,
+                std::uint64_t maxCost, std::int32_t numThreads, bool deterministic, std::vector<std::pair<std::int32_t, std::int32_t>> &pairs)
+{
+    std::vector<const PlayerRecord *> records;
+    records.reserve(subset.size());
+    for (const auto i : subset)
+        records.push_back(players[i]);
+
+    PairingSearch search(records, matchNum, cache);
+    if (!search.runParallel(maxCost, numThreads, deterministic))
+        return false;
+    for (const auto &pair : search.getPairs())
+        pairs.emplace_back(subset[pair.first], pair.second >= 0 ? subset[pair.second] : -1);
+    return true;
+}
+} // namespace
+
+PairingSearch::PairingSearch(const std::vector<const PlayerRecord *> &players, std::int32_t matchNum, PairingCache *cache)
+    : m_players(players), m_matchNum(matchNum), m_cache(cache)
+{
+    const auto numPlayers = static_cast<std::int32_t>(players.size());
+    m_order.resize(numPlayers);
+    m_byes.resize(numPlayers);
+    m_scores.resize(numPlayers);
+    m_keys.resize(numPlayers);
+    for (std::int32_t i = 0; i < numPlayers; i++)
+    {
+        m_order[i] = i;
+        m_byes[i] = players[i]->receivedByes(matchNum);
+        m_scores[i] = players[i]->getMatchScore(matchNum);
+        m_keys[i] = PairingCache::playerKey(players[i]->getId());
+    }
+    m_pairs.resize(numPlayers / 2 + 1);
+    m_bestPairs.reserve(numPlayers / 2 + 1);
+}
+
+bool PairingSearch::run(std::uint64_t maxCost)
+{
+    std::uint64_t key = 0;
+    for (const auto k : m_keys)
+        key ^= k;
+
+    //most rounds have a free pairing, so look for one before letting the search wander into rematches
+    //the sets this fails on stay in the cache and are skipped quickly by the full search
+    //with score differences counted a free pairing is rare, so go straight to the full search
+    const auto freeCost = m_floatCost == 0 ? std::min<std::uint64_t>(maxCost, 1) : maxCost;
+    m_timedOut = false;
+    for (const auto limit : {freeCost, maxCost})
+    {
+        std::iota(m_order.begin(), m_order.end(), 0);
+        m_limit = limit;
+        m_found = false;
+        m_cancelled = false;
+        m_bestPairs.clear();
+        pairFrom(0, 0, key, 0);
+        if (m_found || limit == maxCost || m_timedOut)
+            break;
+    }
+    addCacheStats();
+    return m_found;
+}
+
+bool PairingSearch::runParallel(std::uint64_t maxCost, std::int32_t numThreads, bool deterministic)
+{
+    if (numThreads <= 1 || static_cast<std::int32_t>(m_order.size()) < PARALLEL_MIN_PLAYERS)
+        return run(maxCost);
+
+    std::uint64_t key = 0;
+    for (const auto k : m_keys)
+        key ^= k;
+
+    struct Worker
+    {
+        PairingSearch search;
+        std::vector<std::pair<std::int32_t, std::int32_t>> pairs;
+        std::uint64_t cost = PAIRING_NO_COST_LIMIT;
+        std::int32_t branch = INT32_MAX;
+    };
+    m_timedOut = false;
+    std::vector<Worker> workers;
+    workers.reserve(numThreads);
+    for (std::int32_t i = 0; i < numThreads; i++)
+    {
+        workers.push_back(Worker{*this, {}});
+        //copies only keep the size of a vector, reserve the pairing buffers so the workers never allocate
+        workers.back().search.m_bestPairs.reserve(m_pairs.size());
+        workers.back().pairs.reserve(m_pairs.size());
+        workers.back().search.m_deterministic = deterministic;
+    }
+
+    //free pass first, like run
+    const auto freeCost = m_floatCost == 0 ? std::min<std::uint64_t>(maxCost, 1) : maxCost;
+    for (const auto limit : {freeCost, maxCost})
+    {
+        //collect the branches in the order the sequential search visits them
+        std::iota(m_order.begin(), m_order.end(), 0);
+        m_limit = limit;
+        m_found = false;
+        m_bestPairs.clear();
+        m_branches.clear();
+        m_branchPairs = PARALLEL_BRANCH_PAIRS;
+        pairFrom(0, 0, key, 0);
+        m_branchPairs = -1;
+
+        SharedBest shared;
+        std::atomic<std::int32_t> next{0};
+        const auto numBranches = static_cast<std::int32_t>(m_branches.size());
+        auto work = [&](Worker &worker)
+        {
+            worker.search.m_shared = &shared;
+            for (auto b = next++; b < numBranches; b = next++)
+            {
+                const auto freeBranch = shared.freeBranch.load();
+                if (freeBranch < b || (!deterministic && freeBranch != INT32_MAX) || worker.search.m_timedOut)
+                    break;
+                worker.search.searchBranch(m_branches[b], b, limit);
+                //a worker takes branches in increasing order, so a later branch only wins if it is cheaper
+                if (worker.search.m_found && worker.search.m_bestCost < worker.cost)
+                {
+                    worker.pairs = worker.search.m_bestPairs;
+                    worker.cost = worker.search.m_bestCost;
+                    worker.branch = b;
+                }
+            }
+            worker.search.m_shared = nullptr;
+        };
+
+        std::vector<std::thread> threads;
+        for (std::int32_t i = 1; i < numThreads; i++)
+            threads.emplace_back(work, std::ref(workers[i]));
+        work(workers[0]);
+        for (auto &thread : threads)
+            thread.join();
+
+        const Worker *best = nullptr;
+        for (const auto &worker : workers)
+        {
+            m_timedOut = m_timedOut || worker.search.m_timedOut;
+            if (worker.branch != INT32_MAX && (best == nullptr || worker.cost < best->cost || (worker.cost == best->cost && worker.branch < best->branch)))
+                best = &worker;
+        }
+        if (best != nullptr)
+        {
+            m_bestPairs = best->pairs;
+            m_bestCost = best->cost;
+            m_found = true;
+            break;
+        }
+        if (m_timedOut)
+            break;
+    }
+    for (auto &worker : workers)
+        worker.search.addCacheStats();
+    addCacheStats();
+    m_branches.clear();
+    std::iota(m_order.begin(), m_order.end(), 0);
+    return m_found;
+}
+
+void PairingSearch::searchBranch(const Branch &branch, std::int32_t index, std::uint64_t limit)
+{
+    m_branch = index;
+    m_limit = limit;
+    m_found = false;
+    m_cancelled = false;
+
+    //the branch players go first, the rest stay in sorted order behind them
+    std::int32_t depth = 0;
+    for (std::int32_t i = 0; i < branch.numPairs; i++)
+    {
+        m_pairs[i] = branch.pairs[i];
+        m_order[depth++] = branch.pairs[i].first;
+        if (branch.pairs[i].second >= 0)
+            m_order[depth++] = branch.pairs[i].second;
+    }
+    auto pos = depth;
+    for (std::int32_t p = 0; p < static_cast<std::int32_t>(m_order.size()); p++)
+    {
+        if (std::find(m_order.begin(), m_order.begin() + depth, p) == m_order.begin() + depth)
+            m_order[pos++] = p;
+    }
+
+    pairFrom(depth, branch.numPairs, branch.key, branch.cost);
+}
+
+bool PairingSearch::syncShared()
+{
+    const auto freeBranch = m_shared->freeBranch.load(std::memory_order_relaxed);
+    if (freeBranch < m_branch || (!m_deterministic && freeBranch != INT32_MAX && freeBranch != m_branch))
+    {
+        m_cancelled = true;
+        return false;
+    }
+    //deterministic workers keep searching for pairings as cheap as the best, an earlier branch wins ties
+    auto limit = m_shared->cost.load(std::memory_order_relaxed);
+    if (m_deterministic && limit != PAIRING_NO_COST_LIMIT)
+        limit++;
+    m_limit = std::min(m_limit, limit);
+    return true;
+}
+
+bool PairingSearch::pastDeadline()
+{
+    //reading the clock on every node would cost more than the node itself
+    if ((++m_nodes & 1023) == 0 && m_deadline != std::chrono::steady_clock::time_point::max() && std::chrono::steady_clock::now() >= m_deadline)
+        m_timedOut = true;
+    return m_timedOut;
+}
+
+void PairingSearch::addCacheStats()
+{
+    if (m_cache != nullptr)
+        m_cache->addStats(m_cacheHits, m_cacheMisses);
+    m_cacheHits = 0;
+    m_cacheMisses = 0;
+}
+
+void PairingSearch::publish(std::uint64_t cost)
+{
+    auto best = m_shared->cost.load();
+    while (cost < best && !m_shared->cost.compare_exchange_weak(best, cost))
+    {
+    }
+    if (cost == 0)
+    {
+        auto freeBranch = m_shared->freeBranch.load();
+        while (m_branch < freeBranch && !m_shared->freeBranch.compare_exchange_weak(freeBranch, m_branch))
+        {
+        }
+    }
+}
+
+void PairingSearch::pairFrom(std::int32_t depth, std::int32_t numPairs, std::uint64_t key, std::uint64_t cost)
+{
+    const auto end = static_cast<std::int32_t>(m_order.size());
+    if (depth >= end)
+        return;
+
+    if (numPairs == m_branchPairs)
+    {
+        Branch branch;
+        std::copy(m_pairs.begin(), m_pairs.begin() + numPairs, branch.pairs);
+        branch.numPairs = numPairs;
+        branch.key = key;
+        branch.cost = cost;
+        m_branches.push_back(branch);
+        return;
+    }
+
+    if (m_shared != nullptr && !syncShared())
+        return;
+
+    if (pastDeadline())
+    {
+        m_cancelled = true;
+        return;
+    }
+
+    //skip sets of players that can't be paired cheaply enough to beat the best pairing
+    if (m_cache != nullptr)
+    {
+        const auto bound = m_cache->lowerBound(key);
+        if (bound > 0 && m_limit - cost <= bound)
+        {
+            m_cacheHits++;
+            return;
+        }
+        m_cacheMisses++;
+    }
+
+    const auto p1 = m_order[depth];
+    const auto &player1 = *m_players[p1];
+    const auto remaining = end - depth - 1;
+
+    //free options are tried first so the first pairings found are cheap and prune the rest of the search
+    //candidates are rotated into m_order[depth + 1] one swap at a time, which keeps the rest in sorted order
+    for (std::int32_t pass = 0; pass < 2; pass++)
+    {
+        const bool freePass = pass == 0;
+        if (!freePass && cost + PAIRING_REMATCH_COST >= m_limit) //nothing that costs anything can fit
+            break;
+        for (auto k = depth + 1; k < end; k++)
+        {
+            if (k > depth + 1)
+                std::swap(m_order[depth + 1], m_order[k]);
+            const auto p2 = m_order[depth + 1];
+            const auto &player2 = *m_players[p2];
+            auto timesPlayed = player1.timesPlayed(player2.getId(), m_matchNum);
+            if (freePass && timesPlayed > 0)
+                continue;
+            timesPlayed = std::max(timesPlayed, player2.timesPlayed(player1.getId(), m_matchNum));
+            if ((timesPlayed == 0) != freePass)
+                continue;
+            auto pairCost = cost + static_cast<std::uint64_t>(timesPlayed) * PAIRING_REMATCH_COST;
+            if (m_floatCost > 0)
+                pairCost += static_cast<std::uint64_t>(std::abs(m_scores[p1] - m_scores[p2])) * m_floatCost;
+            if (pairCost >= m_limit)
+                continue;
+            m_pairs[numPairs] = std::make_pair(p1, p2);
+            if (remaining == 1) //only one player left, and it's cheaper than the best so far
+                keepPairing(numPairs + 1, pairCost);
+            else
+            {
+                pairFrom(depth + 2, numPairs + 1, key ^ m_keys[p1] ^ m_keys[p2], pairCost);
+            }
+            if (m_limit == 0 || m_cancelled) //can't do better than free or another worker won, leave m_order as is
+                return;
+        }
+        //undo the swaps
+        if (remaining > 1)
+            std::rotate(m_order.begin() + depth + 1, m_order.begin() + depth + 2, m_order.end());
+
+        //try a bye for the current player if there is an even number of other players
+        const auto byeCost = cost + static_cast<std::uint64_t>(m_byes[p1]) * PAIRING_REPEAT_BYE_COST;
+        if ((remaining & 1) == 0 && (m_byes[p1] == 0) == freePass && byeCost < m_limit)
+        {
+            m_pairs[numPairs] = std::make_pair(p1, -1);
+            if (remaining == 0) //the last player takes the bye
+                keepPairing(numPairs + 1, byeCost);
+            else
+                pairFrom(depth + 1, numPairs + 1, key ^ m_keys[p1], byeCost);
+            if (m_limit == 0 || m_cancelled)
+                return;
+        }
+    }
+
+    //every pairing of this set cheaper than m_limit - cost has been tried, unless branches were only collected
+    if (m_cache != nullptr && m_limit > cost && !m_cancelled && m_branchPairs < 0)
+        m_cache->insert(key, m_limit - cost);
+}
+
+void PairingSearch::keepPairing(std::int32_t numPairs, std::uint64_t cost)
+{
+    m_limit = cost;
+    m_bestCost = cost;
+    m_found = true;
+    m_bestPairs.assign(m_pairs.begin(), m_pairs.begin() + numPairs);
+    if (m_shared != nullptr)
+        publish(cost);
+}
+
+bool bracketPairing(const std::vector<const PlayerRecord *> &players, std::int32_t matchNum, PairingCache *cache, std::int32_t numThreads, bool deterministic,
+                    std::vector<std::pair<std::int32_t, std::int32_t>> &pairs)
+{
+    const auto numPlayers = static_cast<std::int32_t>(players.size());
+    const auto numPairs = pairs.size();
+    std::vector<std::int32_t> downFloaters; //players moved down from the previous bracket
+    std::int32_t next = 0;
+    while (next < numPlayers)
+    {
+        //the bracket is any floaters from above plus every player with the next score
+        auto bracket = downFloaters;
+        downFloaters.clear();
+        const auto score = players[next]->getMatchScore(matchNum);
+        while (next < numPlayers && players[next]->getMatchScore(matchNum) == score)
+            bracket.push_back(next++);
+
+        while (true)
+        {
+            if (next >= numPlayers)
+            {
+                //last bracket takes the bye, and allows byes and rematches if nothing else works
+                if (!pairSubset(players, bracket, matchNum, cache, PAIRING_NO_COST_LIMIT, numThreads, deterministic, pairs))
+                {
+                    pairs.resize(numPairs); //the brackets above were paired already
+                    return false;
+                }
+                break;
+            }
+
+            if ((bracket.size() & 1) == 0)
+            {
+                if (pairSubset(players, bracket, matchNum, cache, 1, numThreads, deterministic, pairs)) //only free pairings
+                    break;
+            }
+            else
+            {
+                //odd bracket, float one player down starting from the lowest ranked
+                bool floated = false;
+                for (auto i = static_cast<std::int32_t>(bracket.size()) - 1; i >= 0 && !floated; i--)
+                {
+                    auto remaining = bracket;
+                    remaining.erase(remaining.begin() + i);
+                    if (remaining.empty() || pairSubset(players, remaining, matchNum, cache, 1, numThreads, deterministic, pairs))
+                    {
+                        downFloaters.push_back(bracket[i]);
+                        floated = true;
+                    }
+                }
+                if (floated)
+                    break;
+            }
+
+            //the bracket can't be paired on its own, so float the highest ranked player of the next bracket up
+            bracket.push_back(next++);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,172 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "pairingCache.hpp"
+#include "playerRecord.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+//cost of pairing two players, per point of score difference (only if enabled with setFloatCost)
+constexpr std::uint64_t PAIRING_FLOAT_COST = 1;
+//cost of pairing two players, per previous matchup between them. outweighs any score differences
+constexpr std::uint64_t PAIRING_REMATCH_COST = std::uint64_t(1) << 20;
+//cost of a bye, per previous bye of the player. outweighs any number of rematches
+constexpr std::uint64_t PAIRING_REPEAT_BYE_COST = std::uint64_t(1) << 44;
+constexpr std::uint64_t PAIRING_NO_COST_LIMIT = UINT64_MAX;
+//number of pairings that make up a branch of PairingSearch::runParallel
+constexpr std::int32_t PARALLEL_BRANCH_PAIRS = 2;
+
+//Branch and bound search for the lowest cost pairing of a sorted player list.
+//All buffers are sized once in the constructor, the search itself works in place on an index array
+//and never allocates, so it can be run repeatedly with different limits.
+class PairingSearch
+{
+public:
+    //players must be sorted based on previous scores and outlive the search
+    //matchNum is max match to consider (usually the previous match)
+    //cache may be null, otherwise it is used to skip player sets that can't beat the best pairing found so far
+    //the cache is shared by the workers of runParallel
+    PairingSearch(const std::vector<const PlayerRecord *> &players, std::int32_t matchNum, PairingCache *cache);
+
+    //adds costPerPoint for every point of score difference between paired players, 0 ignores scores
+    inline void setFloatCost(std::uint64_t costPerPoint)
+    {
+        m_floatCost = costPerPoint;
+    }
+
+    //stop searching at deadline and keep the best pairing found so far
+    inline void setDeadline(std::chrono::steady_clock::time_point deadline)
+    {
+        m_deadline = deadline;
+    }
+
+    //true if the last run stopped at the deadline, so the pairing may not be the cheapest
+    inline bool timedOut() const
+    {
+        return m_timedOut;
+    }
+
+    //finds the lowest cost pairing, only pairings costing less than maxCost are accepted
+    //among pairings of equal cost the first in score order is kept
+    //returns true if pairing found
+    bool run(std::uint64_t maxCost = PAIRING_NO_COST_LIMIT);
+
+    //same as run, but the top of the search tree is split into branches that numThreads workers take in turn
+    //a free pairing found in one branch cancels the branches after it, or every other branch if not deterministic
+    //if deterministic the pairing is always the one run would find, otherwise it is any of the lowest cost pairings
+    bool runParallel(std::uint64_t maxCost, std::int32_t numThreads, bool deterministic);
+
+    //pairings found by the last successful run, as indexes into players
+    //the second index is -1 for a bye
+    inline const std::vector<std::pair<std::int32_t, std::int32_t>> &getPairs() const
+    {
+        return m_bestPairs;
+    }
+
+    //cost of the pairings found by the last successful run
+    inline std::uint64_t getCost() const
+    {
+        return m_bestCost;
+    }
+
+private:
+    //the first pairings of a part of the search tree, see runParallel
+    struct Branch
+    {
+        std::pair<std::int32_t, std::int32_t> pairs[PARALLEL_BRANCH_PAIRS];
+        std::int32_t numPairs = 0;
+        std::uint64_t key = 0;
+        std::uint64_t cost = 0;
+    };
+
+    //best pairing found by any worker of runParallel
+    struct SharedBest
+    {
+        std::atomic<std::uint64_t> cost{PAIRING_NO_COST_LIMIT};
+        std::atomic<std::int32_t> freeBranch{INT32_MAX}; //lowest branch with a free pairing
+    };
+
+    //pair the players in m_order[depth, end), writing pairings from m_pairs[numPairs]
+    //key identifies the unpaired players for the cache, cost is the cost of the pairings made so far
+    void pairFrom(std::int32_t depth, std::int32_t numPairs, std::uint64_t key, std::uint64_t cost);
+
+    //keep the complete pairing in m_pairs[0, numPairs) as the best so far
+    void keepPairing(std::int32_t numPairs, std::uint64_t cost);
+
+    //search the part of the tree below branch, keeping the best pairing in m_bestPairs
+    void searchBranch(const Branch &branch, std::int32_t index, std::uint64_t limit);
+
+    //pulls the best cost of the other workers into m_limit, returns false if this branch is cancelled
+    bool syncShared();
+
+    //tell the other workers about a pairing
+    void publish(std::uint64_t cost);
+
+    //move the lookup counters into the cache statistics
+    void addCacheStats();
+
+    //checks the clock every few nodes, returns true once the deadline has passed
+    bool pastDeadline();
+
+    const std::vector<const PlayerRecord *> &m_players;
+    std::int32_t m_matchNum = -1;
+    PairingCache *m_cache = nullptr;
+    std::uint64_t m_cacheHits = 0;
+    std::uint64_t m_cacheMisses = 0;
+
+    std::vector<std::int32_t> m_order; //unpaired players are kept in sorted order at the back
+    std::vector<std::int32_t> m_byes; //previous byes per player
+    std::vector<std::int64_t> m_scores; //previous score per player
+    std::vector<std::uint64_t> m_keys; //cache key per player
+    std::vector<std::pair<std::int32_t, std::int32_t>> m_pairs; //pairings on the current branch
+    std::vector<std::pair<std::int32_t, std::int32_t>> m_bestPairs;
+    std::uint64_t m_limit = 0; //any new pairing must be cheaper than this
+    std::uint64_t m_bestCost = 0;
+    bool m_found = false;
+    std::uint64_t m_floatCost = 0;
+
+    std::chrono::steady_clock::time_point m_deadline = std::chrono::steady_clock::time_point::max();
+    std::uint32_t m_nodes = 0;
+    bool m_timedOut = false;
+
+    std::int32_t m_branchPairs = -1; //pairFrom records a branch instead of searching once this many pairs are made
+    std::vector<Branch> m_branches;
+    SharedBest *m_shared = nullptr;
+    std::int32_t m_branch = 0;
+    bool m_deterministic = true;
+    bool m_cancelled = false;
+};
+
+//pair each score group on its own with PairingSearch, floating players down to (or up from) the next group when a group can't be paired
+//players must be sorted based on previous scores, matchNum is max match to consider (usually the previous match)
+//the searches share cache and run on numThreads threads, see PairingSearch::runParallel
+//appends the pairings to pairs as indexes into players, the second index -1 for a bye
+//returns true if pairing found, otherwise pairs is left as it was
+bool bracketPairing(const std::vector<const PlayerRecord *> &players, std::int32_t matchNum, PairingCache *cache, std::int32_t numThreads, bool deterministic,
+                    std::vector<std::pair<std::int32_t, std::int32_t>> &pairs);
@@ -28,21 +28,16 @@
 #include <QObject>
 #include <QList>
 
+#include <string>
+#include <vector>
+
 #include "json.hpp"
+#include "matchResult.hpp"
+#include "playerRecord.hpp"
 
 class Player;
-
-struct MatchResult
-{
-    bool played = false; //set to true when this match has been played, even if it was a bye. Scores are ignored if false
-    bool matchWin = false;
-    bool matchTie = false;
-    bool bye = false;
-    std::uint32_t wins = 0;
-    std::uint32_t losses = 0;
-    std::uint32_t ties = 0;
-    std::shared_ptr<Player> opponent = nullptr;
-};
+class PlayerIndex;
+class PlayerTable;
 
 class Player : public QObject
 {
@@ -50,101 +45,144 @@ class Player : public QObject
 public:
     Player() : QObject() {}
 
-    Player(const QString &name, std::int32_t id) : QObject()
-    {
-        m_name = name;
-        m_id = id;
-    }
+    Player(const QString &name, std::int32_t id) : QObject(), m_record(name.toStdString(), id) {}
 
     Player(const Player &pl)
     {
-        m_name = pl.m_name;
-        m_id = pl.m_id;
-        m_matchResults = pl.m_matchResults;
+        m_record = pl.m_record;
+        m_table = pl.m_table;
     }
 
     Player(Player &&pl)
     {
-        m_name = std::move(pl.m_name);
-        m_id = std::move(pl.m_id);
-        m_matchResults = std::move(pl.m_matchResults);
+        m_record = std::move(pl.m_record);
+        m_table = std::move(pl.m_table);
     }
 
     ~Player() = default;
 
     Player &operator=(const Player &pl)
     {
-        m_name = pl.m_name;
-        m_id = pl.m_id;
-        m_matchResults = pl.m_matchResults;
+        m_record = pl.m_record;
+        m_table = pl.m_table;
         return *this;
     }
 
     Player &operator=(Player &&pl)
     {
-        m_name = std::move(pl.m_name);
-        m_id = std::move(pl.m_id);
-        m_matchResults = std::move(pl.m_matchResults);
+        m_record = std::move(pl.m_record);
+        m_table = std::move(pl.m_table);
         return *this;
     }
 
-    std::uint32_t getMatchScore(std::int32_t maxMatch = -1) const;
-
-    std::uint32_t getGameScore(std::int32_t maxMatch = -1) const;
-
-    double getMatchWinPercentage(std::int32_t maxMatch = -1) const;
-
-    double getGameWinPercentage(std::int32_t maxMatch = -1) const;
-
-    double getOpponentMatchWinPercentage(std::int32_t maxMatch = -1) const;
+    inline std::uint32_t getMatchScore(std::int32_t maxMatch = -1) const
+    {
+        return m_record.getMatchScore(maxMatch);
+    }
 
-    double getOpponentGameWinPercentage(std::int32_t maxMatch = -1) const;
+    inline std::uint32_t getGameScore(std::int32_t maxMatch = -1) const
+    {
+        return m_record.getGameScore(maxMatch);
+    }
 
-    bool scoresValid(QString *reason, std::int32_t maxMatch = -1) const;
+    inline double getMatchWinPercentage(std::int32_t maxMatch = -1) const
+    {
+        return m_record.getMatchWinPercentage(maxMatch);
+    }
 
-    MatchResult getResultsForMatch(std::int32_t maxMatch = -1) const;
+    inline double getGameWinPercentage(std::int32_t maxMatch = -1) const
+    {
+        return m_record.getGameWinPercentage(maxMatch);
+    }
 
-    QList<std::int32_t> getPreviousOpponents(std::int32_t maxMatch = -1) const;
+    //number of times this player has been paired against the given player id, without allocating
+    inline std::int32_t timesPlayed(std::int32_t id, std::int32_t maxMatch = -1) const
+    {
+        return m_record.timesPlayed(id, maxMatch);
+    }
 
-    std::int32_t receivedByes(std::int32_t maxMatch = -1) const;
+    inline std::int32_t receivedByes(std::int32_t maxMatch = -1) const
+    {
+        return m_record.receivedByes(maxMatch);
+    }
 
     inline QString getName() const
     {
-        return m_name;
+        return QString::fromStdString(m_record.getName());
     }
 
     inline void setName(const QString &name)
     {
-        m_name = name;
+        m_record.setName(name.toStdString());
     }
 
     inline std::int32_t getId() const
     {
-        return m_id;
+        return m_record.getId();
     }
 
     inline void setId(std::int32_t id)
     {
-        m_id = id;
+        m_record.setId(id);
     }
 
     inline MatchResult getMatchResult(std::size_t matchNum) const
     {
-      return m_matchResults[matchNum];
+      return m_record.getMatchResults()[matchNum].unpack();
+    }
+
+    //packed, see PackedMatchResult, this player's column of the player table's result matrix
+    inline ResultMatrix::Column getMatchResults() const
+    {
+        return m_record.getMatchResults();
     }
 
-    double getTiebrokenScore(std::int32_t maxMatch = -1) const;
+    //the Qt-free results and scores this player wraps
+    inline const PlayerRecord &getRecord() const
+    {
+        return m_record;
+    }
+
+    //the opponent of a result, looked up in the player table this player belongs to
+    //nullptr for byes, unknown opponents or a player outside a table
+    Player *getOpponent(const PackedMatchResult &result) const;
+
+    //set by PlayerTable
+    inline void setPlayerTable(const PlayerTable *table)
+    {
+        m_table = table;
+    }
+
+    //set by PlayerTable, results are only kept inside a matrix
+    inline void setResultMatrix(ResultMatrix *results)
+    {
+        m_record.setResultMatrix(results);
+    }
+
+    //points and limits used by the getters above, BestOf3Scoring unless set
+    inline const ScoringRules &getScoringRules() const
+    {
+        return m_record.getScoringRules();
+    }
+
+    void setScoringRules(const ScoringRules &rules);
 
     nlohmann::json toJson() const;
     bool load(const nlohmann::json& j);
-    bool finalizeLoad(const QList<std::shared_ptr<Player>>& playerList);
+    //resolves the opponent names read by load to ids and stores the results, the players should be in a PlayerTable by now
+    bool finalizeLoad(const PlayerIndex& index);
 
 public slots:
     void setMatchResults(std::int32_t matchNum, const MatchResult &result);
     void setMatchPlayed(std::int32_t matchNum, bool played);
 
+signals:
+    //emitted by setMatchResults and setMatchPlayed
+    void resultsChanged(Player *player);
+
 private:
-    std::int32_t m_id = -1;
-    QString m_name = "";
-    QList<MatchResult> m_matchResults;
+    PlayerRecord m_record;
+    const PlayerTable *m_table = nullptr;
+    std::vector<PackedMatchResult> m_loadedResults; //results read by load, until finalizeLoad
+    std::vector<std::string> m_loadedOpponents; //opponent names read by load, one per result, until finalizeLoad
 };
@@ -0,0 +1,52 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <QList>
+#include "player.hpp"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+//Players of a tournament file by name, built once while loading (MainWindow::readTournament).
+//Save files refer to opponents and pairings by name, so every reference resolves with one hash lookup
+//instead of a scan of the player list. Ids need no index of their own, PlayerTable is indexed by id.
+class PlayerIndex
+{
+public:
+    explicit PlayerIndex(const QList<std::shared_ptr<Player>> &players);
+
+    //nullptr for unknown names, the first player in the list for duplicate names
+    inline std::shared_ptr<Player> find(const std::string &name) const
+    {
+        const auto it = m_byName.find(name);
+        return it != m_byName.end() ? it->second : nullptr;
+    }
+
+private:
+    std::unordered_map<std::string, std::shared_ptr<Player>> m_byName;
+};
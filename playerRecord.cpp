@@ -0,0 +1,246 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "playerRecord.hpp"
+
+#include <algorithm>
+
+namespace
+{
+//rules of a custom format, read at run time by PlayerRecord::sumHistory
+struct CustomScoring
+{
+    const ScoringRules &custom;
+
+    inline const ScoringRules &rules() const
+    {
+        return custom;
+    }
+};
+} // namespace
+
+std::uint32_t PlayerRecord::getMatchScore(std::int32_t maxMatch) const
+{
+    return historyAt(maxMatch).matchPoints;
+}
+
+std::uint32_t PlayerRecord::getGameScore(std::int32_t maxMatch) const
+{
+    return historyAt(maxMatch).gamePoints;
+}
+
+double PlayerRecord::getMatchWinPercentage(std::int32_t maxMatch) const
+{
+    const auto totals = historyAt(maxMatch);
+    int score = totals.matchPoints;
+    int max = totals.matchesPlayed * m_rules.matchWinPoints;
+
+    double winPer = static_cast<double>(score) / static_cast<double>(max);
+    if (winPer < m_rules.minimumWinPercentage)
+        winPer = m_rules.minimumWinPercentage;
+
+    return winPer;
+}
+
+double PlayerRecord::getGameWinPercentage(std::int32_t maxMatch) const
+{
+    const auto totals = historyAt(maxMatch);
+    int score = totals.gamePoints;
+    int max = totals.gamesPlayed * m_rules.gameWinPoints;
+
+    double winPer = static_cast<double>(score) / static_cast<double>(max);
+    if (winPer < m_rules.minimumWinPercentage)
+        winPer = m_rules.minimumWinPercentage;
+
+    return winPer;
+}
+
+std::int32_t PlayerRecord::receivedByes(std::int32_t maxMatch) const
+{
+    return historyAt(maxMatch).byes;
+}
+
+std::int32_t PlayerRecord::timesPlayed(std::int32_t id, std::int32_t maxMatch) const
+{
+    if (!hasPlayed(id))
+        return 0;
+
+    std::int32_t maxMatchNum = 0;
+    if (maxMatch < 0)
+        maxMatchNum = m_numMatches - 1;
+    else
+        maxMatchNum = std::min(maxMatch, m_numMatches - 1);
+
+    const auto results = getMatchResults();
+    std::int32_t count = 0;
+    for (std::int32_t i = 0; i <= maxMatchNum; i++)
+    {
+        if (results[i].opponent() == id)
+            count++;
+    }
+    return count;
+}
+
+void PlayerRecord::setId(std::int32_t id)
+{
+    moveResults(m_results, id);
+}
+
+void PlayerRecord::setResultMatrix(ResultMatrix *results)
+{
+    moveResults(results, m_id);
+}
+
+void PlayerRecord::setMatchResult(std::int32_t matchNum, const MatchResult &result)
+{
+    if (!reserveMatch(matchNum))
+        return;
+    PackedMatchResult packed(result);
+    packed.setPlayed(true);
+    m_results->set(matchNum, m_id, packed);
+    updatePlayedMask();
+    updateHistory(matchNum);
+}
+
+void PlayerRecord::setMatchPlayed(std::int32_t matchNum, bool played)
+{
+    if (!reserveMatch(matchNum))
+        return;
+    auto packed = m_results->get(matchNum, m_id);
+    packed.setPlayed(played);
+    m_results->set(matchNum, m_id, packed);
+    updateHistory(matchNum);
+}
+
+void PlayerRecord::setMatchResults(std::vector<PackedMatchResult> results)
+{
+    if (m_results != nullptr && m_id >= 0)
+    {
+        const auto numMatches = static_cast<std::int32_t>(results.size());
+        m_results->resize(numMatches, m_id + 1);
+        for (std::int32_t i = 0; i < numMatches; i++)
+            m_results->set(i, m_id, results[i]);
+        //matches past the new results are cleared, not just hidden
+        for (std::int32_t i = numMatches; i < m_numMatches; i++)
+            m_results->set(i, m_id, PackedMatchResult());
+        m_numMatches = numMatches;
+    }
+    updatePlayedMask();
+    updateHistory(0);
+}
+
+void PlayerRecord::setScoringRules(const ScoringRules &rules)
+{
+    m_rules = rules;
+    updateHistory(0);
+}
+
+void PlayerRecord::updateHistory(std::int32_t fromMatch)
+{
+    //the preset formats get a loop with their points folded in
+    if (m_rules == BestOf3Scoring::rules())
+        sumHistory(fromMatch, BestOf3Scoring());
+    else if (m_rules == BestOf1Scoring::rules())
+        sumHistory(fromMatch, BestOf1Scoring());
+    else if (m_rules == BestOf5Scoring::rules())
+        sumHistory(fromMatch, BestOf5Scoring());
+    else
+        sumHistory(fromMatch, CustomScoring{m_rules});
+}
+
+template<typename Scoring>
+void PlayerRecord::sumHistory(std::int32_t fromMatch, const Scoring &scoring)
+{
+    const ScoringRules rules = scoring.rules();
+
+    //matches skipped over when m_numMatches grew have no sums yet either
+    fromMatch = std::min(fromMatch, static_cast<std::int32_t>(m_history.size()));
+    m_history.resize(m_numMatches);
+    const auto results = getMatchResults();
+    for (std::int32_t i = std::max(fromMatch, 0); i < m_numMatches; i++)
+    {
+        ResultTotals totals = i > 0 ? m_history[i - 1] : ResultTotals{};
+        const auto &result = results[i];
+        if (result.played())
+        {
+            totals.matchesPlayed++;
+            totals.gamesPlayed += result.gamesPlayed();
+            totals.byes += result.bye() ? 1 : 0;
+            totals.matchPoints += rules.resultMatchPoints(result);
+            totals.gamePoints += rules.resultGamePoints(result);
+        }
+        m_history[i] = totals;
+    }
+}
+
+void PlayerRecord::moveResults(ResultMatrix *results, std::int32_t id)
+{
+    if (results == m_results && id == m_id)
+        return;
+
+    std::vector<PackedMatchResult> moved;
+    moved.reserve(m_numMatches);
+    for (const auto &result : getMatchResults())
+        moved.push_back(result);
+    //an empty result list clears the old column
+    setMatchResults({});
+
+    m_results = results;
+    m_id = id;
+    setMatchResults(std::move(moved));
+}
+
+bool PlayerRecord::reserveMatch(std::int32_t matchNum)
+{
+    if (m_results == nullptr || m_id < 0 || matchNum < 0)
+        return false;
+    m_results->resize(matchNum + 1, m_id + 1);
+    m_numMatches = std::max(m_numMatches, matchNum + 1);
+    return true;
+}
+
+PlayerRecord::ResultTotals PlayerRecord::historyAt(std::int32_t maxMatch) const
+{
+    if (m_history.empty())
+        return ResultTotals{};
+    if (maxMatch < 0 || static_cast<std::size_t>(maxMatch) >= m_history.size())
+        return m_history.back();
+    return m_history[maxMatch];
+}
+
+void PlayerRecord::updatePlayedMask()
+{
+    //rebuilt from scratch since a result may replace an earlier opponent
+    std::fill(m_playedMask.begin(), m_playedMask.end(), 0);
+    for (const auto &mr : getMatchResults())
+    {
+        if (mr.opponent() < 0)
+            continue;
+        const auto id = static_cast<std::size_t>(mr.opponent());
+        if (m_playedMask.size() <= id / 64)
+            m_playedMask.resize(id / 64 + 1, 0);
+        m_playedMask[id / 64] |= std::uint64_t(1) << (id % 64);
+    }
+}
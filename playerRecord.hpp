@@ -0,0 +1,159 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "matchResult.hpp"
+#include "resultMatrix.hpp"
+#include "scoringRules.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//One player's results and the scores derived from them as a plain value, without Qt, so the core library (swisscore)
+//can hold large fields cheaply. Player wraps one for the GUI and Tournament keeps one per player.
+//The results themselves are the record's column (its id) of a ResultMatrix shared by the whole field,
+//a record outside a matrix has no results. Scores for any match come from prefix sums, see updateHistory.
+class PlayerRecord
+{
+public:
+    PlayerRecord() = default;
+
+    //results may be null, see setResultMatrix
+    PlayerRecord(const std::string &name, std::int32_t id, ResultMatrix *results = nullptr) : m_id(id), m_name(name), m_results(results) {}
+
+    std::uint32_t getMatchScore(std::int32_t maxMatch = -1) const;
+
+    std::uint32_t getGameScore(std::int32_t maxMatch = -1) const;
+
+    double getMatchWinPercentage(std::int32_t maxMatch = -1) const;
+
+    double getGameWinPercentage(std::int32_t maxMatch = -1) const;
+
+    std::int32_t receivedByes(std::int32_t maxMatch = -1) const;
+
+    //true if this player has been paired against the given player id in any match
+    inline bool hasPlayed(std::int32_t id) const
+    {
+        const auto word = static_cast<std::size_t>(id) / 64;
+        return id >= 0 && word < m_playedMask.size() && ((m_playedMask[word] >> (id % 64)) & 1);
+    }
+
+    //number of times this player has been paired against the given player id, without allocating
+    std::int32_t timesPlayed(std::int32_t id, std::int32_t maxMatch = -1) const;
+
+    inline const std::string &getName() const
+    {
+        return m_name;
+    }
+
+    inline void setName(const std::string &name)
+    {
+        m_name = name;
+    }
+
+    inline std::int32_t getId() const
+    {
+        return m_id;
+    }
+
+    //the results move to the column of the new id
+    void setId(std::int32_t id);
+
+    //moves the results into the column of this record's id in results, nullptr drops them
+    //the matrix must outlive the record, or the record be moved to another matrix first
+    void setResultMatrix(ResultMatrix *results);
+
+    //packed, see PackedMatchResult, up to the last match set for this player
+    //only good until the next result is set, see ResultMatrix::Column
+    inline ResultMatrix::Column getMatchResults() const
+    {
+        if (m_results == nullptr || m_id < 0)
+            return ResultMatrix::Column(nullptr, 0, 0);
+        return m_results->getPlayer(m_id, m_numMatches);
+    }
+
+    //an unplayed result for matches past the last one
+    inline MatchResult getMatchResult(std::int32_t matchNum) const
+    {
+        if (matchNum < 0 || matchNum >= m_numMatches || m_results == nullptr)
+            return MatchResult{};
+        return m_results->get(matchNum, m_id).unpack();
+    }
+
+    //stores the result of a match and marks it played, results are only kept inside a matrix
+    void setMatchResult(std::int32_t matchNum, const MatchResult &result);
+
+    void setMatchPlayed(std::int32_t matchNum, bool played);
+
+    //replaces every result at once, e.g. when loading
+    void setMatchResults(std::vector<PackedMatchResult> results);
+
+    //points and limits used by the getters above, BestOf3Scoring unless set
+    inline const ScoringRules &getScoringRules() const
+    {
+        return m_rules;
+    }
+
+    void setScoringRules(const ScoringRules &rules);
+
+private:
+    //sums over the played matches up to a match
+    struct ResultTotals
+    {
+        std::int32_t matchPoints = 0;
+        std::int32_t gamePoints = 0;
+        std::int32_t gamesPlayed = 0;
+        std::int32_t matchesPlayed = 0;
+        std::int32_t byes = 0;
+    };
+
+    std::int32_t m_id = -1;
+    std::string m_name;
+    ResultMatrix *m_results = nullptr; //not owned
+    std::int32_t m_numMatches = 0; //matches up to the last one set for this player
+    std::vector<std::uint64_t> m_playedMask; //one bit per opponent id, set if paired in any match
+    std::vector<ResultTotals> m_history; //m_history[i] sums matches 0 to i, one per match
+    ScoringRules m_rules = BestOf3Scoring::rules();
+
+    //moves the results to column id of results, clearing the column they leave
+    void moveResults(ResultMatrix *results, std::int32_t id);
+
+    //grows the matrix and m_numMatches to hold matchNum, returns false outside a matrix
+    bool reserveMatch(std::int32_t matchNum);
+
+    void updatePlayedMask();
+
+    //recompute m_history from fromMatch to the last match
+    void updateHistory(std::int32_t fromMatch);
+
+    //updateHistory for the rules given by scoring.rules()
+    template<typename Scoring>
+    void sumHistory(std::int32_t fromMatch, const Scoring &scoring);
+
+    //totals up to maxMatch (-1 for all matches)
+    ResultTotals historyAt(std::int32_t maxMatch) const;
+};
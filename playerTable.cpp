@@ -0,0 +1,70 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "playerTable.hpp"
+
+std::shared_ptr<Player> PlayerTable::create(const QString &name)
+{
+    auto player = std::make_shared<Player>(name, nextId());
+    add(player);
+    return player;
+}
+
+void PlayerTable::add(const std::shared_ptr<Player> &player)
+{
+    const auto current = get(player->getId());
+    if (player->getId() < 0 || (current != nullptr && current != player.get()))
+        player->setId(nextId());
+    if (static_cast<std::size_t>(player->getId()) >= m_players.size())
+        m_players.resize(player->getId() + 1);
+    m_players[player->getId()] = player;
+    player->setPlayerTable(this);
+    player->setResultMatrix(&m_results);
+}
+
+std::vector<const PlayerRecord *> PlayerTable::getRecords() const
+{
+    std::vector<const PlayerRecord *> records(m_players.size(), nullptr);
+    for (std::size_t id = 0; id < m_players.size(); id++)
+    {
+        if (m_players[id] != nullptr)
+            records[id] = &m_players[id]->getRecord();
+    }
+    return records;
+}
+
+void PlayerTable::clear()
+{
+    for (const auto &player : m_players)
+    {
+        if (player != nullptr)
+        {
+            player->setPlayerTable(nullptr);
+            player->setResultMatrix(nullptr);
+        }
+    }
+    m_players.clear();
+    m_results.clear();
+}
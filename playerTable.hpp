@@ -0,0 +1,82 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <QString>
+#include "player.hpp"
+#include "resultMatrix.hpp"
+
+#include <memory>
+#include <vector>
+
+//Every player of a tournament by id, dropped players included, owned by the tournament (MainWindow).
+//Match results refer to opponents by id (MatchResult::opponent) and look them up here,
+//so results copy without touching reference counts and loading needs no placeholder players.
+//The results of every player live in one ResultMatrix held here, each player reads its column from it.
+class PlayerTable
+{
+public:
+    PlayerTable() = default;
+
+    //the players point at m_results
+    PlayerTable(const PlayerTable &) = delete;
+    PlayerTable &operator=(const PlayerTable &) = delete;
+
+    //a new player with the next unused id
+    std::shared_ptr<Player> create(const QString &name);
+
+    //adds a player under its own id, a player without an id or with one already taken gets the next unused id
+    //the player's results move into the table's result matrix
+    void add(const std::shared_ptr<Player> &player);
+
+    //nullptr for ids not in the table
+    inline Player *get(std::int32_t id) const
+    {
+        if (id < 0 || static_cast<std::size_t>(id) >= m_players.size())
+            return nullptr;
+        return m_players[id].get();
+    }
+
+    inline std::int32_t nextId() const
+    {
+        return static_cast<std::int32_t>(m_players.size());
+    }
+
+    //the record of every player, indexed by id with nullptr for unused ids, the opponent lookup Standings takes
+    std::vector<const PlayerRecord *> getRecords() const;
+
+    //every result, one row per match
+    inline const ResultMatrix &getResults() const
+    {
+        return m_results;
+    }
+
+    void clear();
+
+private:
+    std::vector<std::shared_ptr<Player>> m_players; //indexed by id, nullptr for unused ids
+    ResultMatrix m_results; //columns by id
+};
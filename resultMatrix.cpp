@@ -0,0 +1,85 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "resultMatrix.hpp"
+
+#include <algorithm>
+
+void ResultMatrix::clear()
+{
+    m_numRounds = 0;
+    m_numPlayers = 0;
+    m_stride = 0;
+    m_results.clear();
+}
+
+void ResultMatrix::resize(std::int32_t numRounds, std::size_t numPlayers)
+{
+    numRounds = std::max(numRounds, m_numRounds);
+    numPlayers = std::max(numPlayers, m_numPlayers);
+
+    if (numPlayers > m_stride)
+    {
+        //rows move to the wider stride, at least doubling it so late entries stay cheap
+        const auto stride = std::max(numPlayers, m_stride * 2);
+        std::vector<PackedMatchResult> results(numRounds * stride);
+        for (std::int32_t round = 0; round < m_numRounds; round++)
+        {
+            const auto row = m_results.begin() + round * m_stride;
+            std::copy(row, row + m_numPlayers, results.begin() + round * stride);
+        }
+        m_results = std::move(results);
+        m_stride = stride;
+    }
+    else
+    {
+        m_results.resize(numRounds * m_stride);
+    }
+
+    m_numRounds = numRounds;
+    m_numPlayers = numPlayers;
+}
+
+RoundError ResultMatrix::checkRound(std::int32_t round, std::int32_t bestOf, std::size_t *player) const
+{
+    const auto results = getRound(round);
+    for (std::size_t id = 0; id < results.size(); id++)
+    {
+        const auto &result = results[id];
+        if (!result.played() || result.bye())
+            continue;
+        *player = id;
+        if (result.opponent() < 0 || static_cast<std::size_t>(result.opponent()) >= results.size())
+            return RoundError::NoOpponent;
+        const auto &opp = results[result.opponent()];
+        if (!opp.played() || opp.opponent() != static_cast<std::int32_t>(id))
+            return RoundError::OpponentMismatch;
+        if (static_cast<std::int32_t>(result.wins() + opp.wins()) > bestOf || static_cast<std::int32_t>(result.losses() + opp.losses()) > bestOf)
+            return RoundError::TooManyGames;
+        if (result.wins() != opp.losses() || result.losses() != opp.wins() || result.ties() != opp.ties())
+            return RoundError::GamesMismatch;
+    }
+    return RoundError::None;
+}
@@ -0,0 +1,193 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "matchResult.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//the first problem ResultMatrix::checkRound finds in a round
+enum class RoundError
+{
+    None,
+    NoOpponent,       //played, but the opponent isn't in the matrix
+    OpponentMismatch, //the opponent didn't play them
+    TooManyGames,     //more wins or losses than the format allows
+    GamesMismatch,    //wins, losses or ties don't mirror the opponent's
+};
+
+//Results of a whole tournament in one contiguous rounds x players block, round-major.
+//A round is a contiguous row indexed by player id, so round-level work (validating a round,
+//standings after round k) streams through memory, while a player's results are a column a stride apart.
+//The stride grows geometrically, so players joining between rounds don't re-layout the block every time.
+//This is the only copy of the results, PlayerRecord reads its column from here.
+class ResultMatrix
+{
+public:
+    //the results of one round, by player id
+    class Row
+    {
+    public:
+        Row(const PackedMatchResult *data, std::size_t size) : m_data(data), m_size(size) {}
+
+        inline const PackedMatchResult *begin() const
+        {
+            return m_data;
+        }
+
+        inline const PackedMatchResult *end() const
+        {
+            return m_data + m_size;
+        }
+
+        inline const PackedMatchResult &operator[](std::size_t player) const
+        {
+            return m_data[player];
+        }
+
+        inline std::size_t size() const
+        {
+            return m_size;
+        }
+
+    private:
+        const PackedMatchResult *m_data;
+        std::size_t m_size;
+    };
+
+    //the results of one player, by round
+    //growing the matrix moves the results, so a column is only good until the next resize
+    class Column
+    {
+    public:
+        class Iterator
+        {
+        public:
+            Iterator(const PackedMatchResult *data, std::size_t stride) : m_data(data), m_stride(stride) {}
+
+            inline const PackedMatchResult &operator*() const
+            {
+                return *m_data;
+            }
+
+            inline Iterator &operator++()
+            {
+                m_data += m_stride;
+                return *this;
+            }
+
+            inline bool operator!=(const Iterator &other) const
+            {
+                return m_data != other.m_data;
+            }
+
+        private:
+            const PackedMatchResult *m_data;
+            std::size_t m_stride;
+        };
+
+        Column(const PackedMatchResult *data, std::size_t stride, std::int32_t numRounds) : m_data(data), m_stride(stride), m_numRounds(numRounds) {}
+
+        inline Iterator begin() const
+        {
+            return Iterator(m_data, m_stride);
+        }
+
+        inline Iterator end() const
+        {
+            return Iterator(m_data + m_numRounds * m_stride, m_stride);
+        }
+
+        inline const PackedMatchResult &operator[](std::int32_t round) const
+        {
+            return m_data[round * m_stride];
+        }
+
+        inline std::int32_t size() const
+        {
+            return m_numRounds;
+        }
+
+    private:
+        const PackedMatchResult *m_data;
+        std::size_t m_stride;
+        std::int32_t m_numRounds;
+    };
+
+    ResultMatrix() = default;
+
+    void clear();
+
+    //grows the matrix to at least numRounds rounds and numPlayers players, new results are unplayed
+    void resize(std::int32_t numRounds, std::size_t numPlayers);
+
+    inline std::int32_t getNumRounds() const
+    {
+        return m_numRounds;
+    }
+
+    inline std::size_t getNumPlayers() const
+    {
+        return m_numPlayers;
+    }
+
+    inline const PackedMatchResult &get(std::int32_t round, std::size_t player) const
+    {
+        return m_results[round * m_stride + player];
+    }
+
+    inline void set(std::int32_t round, std::size_t player, const PackedMatchResult &result)
+    {
+        m_results[round * m_stride + player] = result;
+    }
+
+    inline Row getRound(std::int32_t round) const
+    {
+        return Row(m_results.data() + round * m_stride, m_numPlayers);
+    }
+
+    inline Column getPlayer(std::size_t player) const
+    {
+        return Column(m_results.data() + player, m_stride, m_numRounds);
+    }
+
+    //only the first numRounds results of a player
+    inline Column getPlayer(std::size_t player, std::int32_t numRounds) const
+    {
+        return Column(m_results.data() + player, m_stride, numRounds);
+    }
+
+    //checks both sides of every played match of a round agree and no match decided more than bestOf games
+    //player is set to the first player with a bad result
+    RoundError checkRound(std::int32_t round, std::int32_t bestOf, std::size_t *player) const;
+
+private:
+    std::int32_t m_numRounds = 0;
+    std::size_t m_numPlayers = 0;
+    std::size_t m_stride = 0; //players per round including room to grow
+    std::vector<PackedMatchResult> m_results; //index round * m_stride + player
+};
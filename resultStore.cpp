@@ -0,0 +1,368 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "resultStore.hpp"
+
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RESULT_STORE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+//The kernel in computeScores is written once against Lanes, a set of unsigned 16 bit lanes,
+//each lane holding one player. Comparisons give all ones or all zeros per lane.
+#if defined(__AVX2__)
+struct Lanes
+{
+    using Vec = __m256i;
+    static constexpr std::size_t WIDTH = 16;
+
+    static inline Vec load(const std::uint8_t *bytes)
+    {
+        return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes)));
+    }
+    static inline Vec set(std::uint16_t value)
+    {
+        return _mm256_set1_epi16(static_cast<short>(value));
+    }
+    static inline Vec add(Vec a, Vec b)
+    {
+        return _mm256_add_epi16(a, b);
+    }
+    //low 16 bits of the products
+    static inline Vec multiply(Vec a, Vec b)
+    {
+        return _mm256_mullo_epi16(a, b);
+    }
+    static inline Vec bitAnd(Vec a, Vec b)
+    {
+        return _mm256_and_si256(a, b);
+    }
+    static inline Vec bitOr(Vec a, Vec b)
+    {
+        return _mm256_or_si256(a, b);
+    }
+    //~a & b
+    static inline Vec andNot(Vec a, Vec b)
+    {
+        return _mm256_andnot_si256(a, b);
+    }
+    static inline Vec equal(Vec a, Vec b)
+    {
+        return _mm256_cmpeq_epi16(a, b);
+    }
+    //adds the lanes to WIDTH 32 bit totals
+    static inline void accumulate(std::int32_t *totals, Vec value)
+    {
+        auto low = reinterpret_cast<__m256i *>(totals);
+        auto high = reinterpret_cast<__m256i *>(totals + 8);
+        _mm256_storeu_si256(low, _mm256_add_epi32(_mm256_loadu_si256(low), _mm256_cvtepu16_epi32(_mm256_castsi256_si128(value))));
+        _mm256_storeu_si256(high, _mm256_add_epi32(_mm256_loadu_si256(high), _mm256_cvtepu16_epi32(_mm256_extracti128_si256(value, 1))));
+    }
+};
+#elif defined(RESULT_STORE_SSE2)
+struct Lanes
+{
+    using Vec = __m128i;
+    static constexpr std::size_t WIDTH = 8;
+
+    static inline Vec load(const std::uint8_t *bytes)
+    {
+        return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(bytes)), _mm_setzero_si128());
+    }
+    static inline Vec set(std::uint16_t value)
+    {
+        return _mm_set1_epi16(static_cast<short>(value));
+    }
+    static inline Vec add(Vec a, Vec b)
+    {
+        return _mm_add_epi16(a, b);
+    }
+    //low 16 bits of the products
+    static inline Vec multiply(Vec a, Vec b)
+    {
+        return _mm_mullo_epi16(a, b);
+    }
+    static inline Vec bitAnd(Vec a, Vec b)
+    {
+        return _mm_and_si128(a, b);
+    }
+    static inline Vec bitOr(Vec a, Vec b)
+    {
+        return _mm_or_si128(a, b);
+    }
+    //~a & b
+    static inline Vec andNot(Vec a, Vec b)
+    {
+        return _mm_andnot_si128(a, b);
+    }
+    static inline Vec equal(Vec a, Vec b)
+    {
+        return _mm_cmpeq_epi16(a, b);
+    }
+    //adds the lanes to WIDTH 32 bit totals
+    static inline void accumulate(std::int32_t *totals, Vec value)
+    {
+        auto low = reinterpret_cast<__m128i *>(totals);
+        auto high = reinterpret_cast<__m128i *>(totals + 4);
+        _mm_storeu_si128(low, _mm_add_epi32(_mm_loadu_si128(low), _mm_unpacklo_epi16(value, _mm_setzero_si128())));
+        _mm_storeu_si128(high, _mm_add_epi32(_mm_loadu_si128(high), _mm_unpackhi_epi16(value, _mm_setzero_si128())));
+    }
+};
+#else
+struct Lanes
+{
+    using Vec = std::uint16_t;
+    static constexpr std::size_t WIDTH = 1;
+
+    static inline Vec load(const std::uint8_t *bytes)
+    {
+        return *bytes;
+    }
+    static inline Vec set(std::uint16_t value)
+    {
+        return value;
+    }
+    static inline Vec add(Vec a, Vec b)
+    {
+        return static_cast<Vec>(a + b);
+    }
+    //low 16 bits of the products
+    static inline Vec multiply(Vec a, Vec b)
+    {
+        return static_cast<Vec>(a * b);
+    }
+    static inline Vec bitAnd(Vec a, Vec b)
+    {
+        return a & b;
+    }
+    static inline Vec bitOr(Vec a, Vec b)
+    {
+        return a | b;
+    }
+    //~a & b
+    static inline Vec andNot(Vec a, Vec b)
+    {
+        return static_cast<Vec>(~a) & b;
+    }
+    static inline Vec equal(Vec a, Vec b)
+    {
+        return a == b ? 0xFFFF : 0;
+    }
+    //adds the lanes to WIDTH 32 bit totals
+    static inline void accumulate(std::int32_t *totals, Vec value)
+    {
+        *totals += value;
+    }
+};
+#endif
+
+//mask ? a : b in each lane, mask lanes are all ones or all zeros
+inline Lanes::Vec select(Lanes::Vec mask, Lanes::Vec a, Lanes::Vec b)
+{
+    return Lanes::bitOr(Lanes::bitAnd(mask, a), Lanes::andNot(mask, b));
+}
+
+//out[i] = score[i] / (pointsEach * available[i]), at least minimumPer, count must be a multiple of 4
+void winPercentages(const std::int32_t *score, const std::int32_t *available, double *out, std::size_t count, double pointsEach, double minimumPer)
+{
+#if defined(__AVX2__)
+    const auto minimum = _mm256_set1_pd(minimumPer);
+    const auto perUnit = _mm256_set1_pd(pointsEach);
+    for (std::size_t i = 0; i < count; i += 4)
+    {
+        const auto s = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i *>(score + i)));
+        const auto a = _mm256_mul_pd(perUnit, _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i *>(available + i))));
+        //max returns its second operand if either is NaN, so players without matches stay NaN like in Player
+        _mm256_storeu_pd(out + i, _mm256_max_pd(minimum, _mm256_div_pd(s, a)));
+    }
+#elif defined(RESULT_STORE_SSE2)
+    const auto minimum = _mm_set1_pd(minimumPer);
+    const auto perUnit = _mm_set1_pd(pointsEach);
+    for (std::size_t i = 0; i < count; i += 2)
+    {
+        const auto s = _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(score + i)));
+        const auto a = _mm_mul_pd(perUnit, _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(available + i))));
+        //max returns its second operand if either is NaN, so players without matches stay NaN like in Player
+        _mm_storeu_pd(out + i, _mm_max_pd(minimum, _mm_div_pd(s, a)));
+    }
+#else
+    for (std::size_t i = 0; i < count; i++)
+    {
+        double winPer = static_cast<double>(score[i]) / (static_cast<double>(available[i]) * pointsEach);
+        if (winPer < minimumPer)
+            winPer = minimumPer;
+        out[i] = winPer;
+    }
+#endif
+}
+} // namespace
+
+void ResultStore::reset(std::size_t numPlayers, std::int32_t numMatches)
+{
+    constexpr std::size_t PADDING = 32;
+
+    m_numPlayers = numPlayers;
+    m_stride = (numPlayers + PADDING - 1) / PADDING * PADDING;
+    m_numMatches = std::max(numMatches, 0);
+
+    const auto size = m_stride * m_numMatches;
+    m_flags.assign(size, 0);
+    m_wins.assign(size, 0);
+    m_losses.assign(size, 0);
+    m_ties.assign(size, 0);
+}
+
+void ResultStore::load(const std::vector<const PlayerRecord *> &players)
+{
+    std::int32_t numMatches = 0;
+    for (const auto player : players)
+        numMatches = std::max(numMatches, player->getMatchResults().size());
+
+    reset(players.size(), numMatches);
+    for (std::size_t i = 0; i < m_numPlayers; i++)
+    {
+        const auto results = players[i]->getMatchResults();
+        for (std::int32_t j = 0; j < results.size(); j++)
+            setResult(i, j, results[j]);
+    }
+}
+
+void ResultStore::load(const ResultMatrix &results)
+{
+    reset(results.getNumPlayers(), results.getNumRounds());
+    for (std::int32_t round = 0; round < m_numMatches; round++)
+    {
+        const auto row = results.getRound(round);
+        for (std::size_t i = 0; i < m_numPlayers; i++)
+            setResult(i, round, row[i]);
+    }
+}
+
+void ResultStore::setResult(std::size_t player, std::int32_t matchNum, const PackedMatchResult &result)
+{
+    if (player >= m_numPlayers || matchNum < 0)
+        return;
+    if (matchNum >= m_numMatches)
+    {
+        m_numMatches = matchNum + 1;
+        const auto size = m_stride * m_numMatches;
+        m_flags.resize(size, 0);
+        m_wins.resize(size, 0);
+        m_losses.resize(size, 0);
+        m_ties.resize(size, 0);
+    }
+
+    const auto index = matchNum * m_stride + player;
+    m_flags[index] = result.getFlags();
+    m_wins[index] = static_cast<std::uint8_t>(result.wins());
+    m_losses[index] = static_cast<std::uint8_t>(result.losses());
+    m_ties[index] = static_cast<std::uint8_t>(result.ties());
+}
+
+void ResultStore::computeScores(FieldScores &scores, std::int32_t maxMatch, const ScoringRules &rules) const
+{
+    //the 16 bit lanes are added to the 32 bit totals every chunkMatches matches, as many as fit
+    //what one match can add to a lane (at least 3 * 255 games played) at most 64 times
+    const std::uint32_t perMatch = std::max({3u * 255u, rules.matchWinPoints, rules.matchTiePoints, rules.matchLossPoints, rules.byeMatchPoints,
+                                             rules.byeGamePoints(), rules.gamePoints(255, 255)});
+    const auto chunkMatches = static_cast<std::int32_t>(std::max<std::uint32_t>(1, std::min<std::uint32_t>(64, 0xFFFF / perMatch)));
+
+    scores.matchPoints.assign(m_stride, 0);
+    scores.gamePoints.assign(m_stride, 0);
+    scores.matchesPlayed.assign(m_stride, 0);
+    scores.gamesPlayed.assign(m_stride, 0);
+    scores.byes.assign(m_stride, 0);
+    scores.matchWinPercentage.assign(m_stride, 0.0);
+    scores.gameWinPercentage.assign(m_stride, 0.0);
+
+    std::int32_t lastMatch = m_numMatches - 1;
+    if (maxMatch >= 0)
+        lastMatch = std::min(maxMatch, lastMatch);
+
+    const auto played = Lanes::set(PackedMatchResult::PLAYED);
+    const auto matchWin = Lanes::set(PackedMatchResult::MATCH_WIN);
+    const auto matchTie = Lanes::set(PackedMatchResult::MATCH_TIE);
+    const auto bye = Lanes::set(PackedMatchResult::BYE);
+    const auto one = Lanes::set(1);
+    const auto winPoints = Lanes::set(static_cast<std::uint16_t>(rules.matchWinPoints));
+    const auto tiePoints = Lanes::set(static_cast<std::uint16_t>(rules.matchTiePoints));
+    const auto lossPoints = Lanes::set(static_cast<std::uint16_t>(rules.matchLossPoints));
+    const auto byePoints = Lanes::set(static_cast<std::uint16_t>(rules.byeMatchPoints));
+    const auto gameWinPoints = Lanes::set(static_cast<std::uint16_t>(rules.gameWinPoints));
+    const auto gameTiePoints = Lanes::set(static_cast<std::uint16_t>(rules.gameTiePoints));
+    const auto byeGamePoints = Lanes::set(static_cast<std::uint16_t>(rules.byeGamePoints()));
+
+    for (std::size_t player = 0; player < m_stride; player += Lanes::WIDTH)
+    {
+        for (std::int32_t firstMatch = 0; firstMatch <= lastMatch; firstMatch += chunkMatches)
+        {
+            auto matchPoints = Lanes::set(0);
+            auto gamePoints = Lanes::set(0);
+            auto matchesPlayed = Lanes::set(0);
+            auto gamesPlayed = Lanes::set(0);
+            auto byes = Lanes::set(0);
+
+            const auto chunkEnd = std::min(firstMatch + chunkMatches - 1, lastMatch);
+            for (std::int32_t match = firstMatch; match <= chunkEnd; match++)
+            {
+                const auto index = match * m_stride + player;
+                const auto flags = Lanes::load(m_flags.data() + index);
+                const auto wins = Lanes::load(m_wins.data() + index);
+                const auto losses = Lanes::load(m_losses.data() + index);
+                const auto ties = Lanes::load(m_ties.data() + index);
+
+                const auto isPlayed = Lanes::equal(Lanes::bitAnd(flags, played), played);
+                const auto isBye = Lanes::bitAnd(isPlayed, Lanes::equal(Lanes::bitAnd(flags, bye), bye));
+                const auto isWin = Lanes::equal(Lanes::bitAnd(flags, matchWin), matchWin);
+                const auto isTie = Lanes::equal(Lanes::bitAnd(flags, matchTie), matchTie);
+
+                const auto points = select(isBye, byePoints, select(isWin, winPoints, select(isTie, tiePoints, lossPoints)));
+                matchPoints = Lanes::add(matchPoints, Lanes::bitAnd(isPlayed, points));
+
+                const auto games = Lanes::add(Lanes::multiply(wins, gameWinPoints), Lanes::multiply(ties, gameTiePoints));
+                gamePoints = Lanes::add(gamePoints, Lanes::bitAnd(isPlayed, select(isBye, byeGamePoints, games)));
+
+                matchesPlayed = Lanes::add(matchesPlayed, Lanes::bitAnd(isPlayed, one));
+                gamesPlayed = Lanes::add(gamesPlayed, Lanes::bitAnd(isPlayed, Lanes::add(Lanes::add(wins, losses), ties)));
+                byes = Lanes::add(byes, Lanes::bitAnd(isBye, one));
+            }
+
+            Lanes::accumulate(scores.matchPoints.data() + player, matchPoints);
+            Lanes::accumulate(scores.gamePoints.data() + player, gamePoints);
+            Lanes::accumulate(scores.matchesPlayed.data() + player, matchesPlayed);
+            Lanes::accumulate(scores.gamesPlayed.data() + player, gamesPlayed);
+            Lanes::accumulate(scores.byes.data() + player, byes);
+        }
+    }
+
+    winPercentages(scores.matchPoints.data(), scores.matchesPlayed.data(), scores.matchWinPercentage.data(), m_stride, rules.matchWinPoints, rules.minimumWinPercentage);
+    winPercentages(scores.gamePoints.data(), scores.gamesPlayed.data(), scores.gameWinPercentage.data(), m_stride, rules.gameWinPoints, rules.minimumWinPercentage);
+}
@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "playerRecord.hpp"
+#include "resultMatrix.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//totals for every player of a ResultStore, indexed like the store
+//the vectors are padded past the last player, padding entries are 0 (NaN for the percentages)
+struct FieldScores
+{
+    std::vector<std::int32_t> matchPoints;
+    std::vector<std::int32_t> gamePoints;
+    std::vector<std::int32_t> matchesPlayed;
+    std::vector<std::int32_t> gamesPlayed; //wins + losses + ties
+    std::vector<std::int32_t> byes;
+    std::vector<double> matchWinPercentage;
+    std::vector<double> gameWinPercentage;
+};
+
+//Match results of a whole field as a structure of arrays, for computing standings of large (simulated) fields.
+//Each field of a result takes one byte per player, and the players of a match are contiguous, so computeScores
+//runs over many players at once with AVX2 (if the build enables it) or SSE2 vectors, or plain scalar code elsewhere.
+//Scores and percentages come out the same as the PlayerRecord getters given the same ScoringRules.
+//Standings takes every player's own scores from here.
+class ResultStore
+{
+public:
+    ResultStore() = default;
+
+    //empties the store and makes room for numPlayers players and numMatches matches
+    void reset(std::size_t numPlayers, std::int32_t numMatches);
+
+    //copies the results of every player, player i of the store is players[i]
+    void load(const std::vector<const PlayerRecord *> &players);
+
+    //copies every round of the matrix, player i of the store is player i of the matrix
+    void load(const ResultMatrix &results);
+
+    //flags and games are copied from the packed result as they are
+    void setResult(std::size_t player, std::int32_t matchNum, const PackedMatchResult &result);
+
+    inline std::size_t getNumPlayers() const
+    {
+        return m_numPlayers;
+    }
+
+    inline std::int32_t getNumMatches() const
+    {
+        return m_numMatches;
+    }
+
+    //computes the totals of every player, counting matches up to maxMatch (-1 for all matches)
+    //points of a single match must stay below 65536, which every realistic format does
+    void computeScores(FieldScores &scores, std::int32_t maxMatch = -1, const ScoringRules &rules = BestOf3Scoring::rules()) const;
+
+private:
+    std::size_t m_numPlayers = 0;
+    std::size_t m_stride = 0; //players per match including padding, a multiple of the widest vector
+    std::int32_t m_numMatches = 0;
+
+    //index matchNum * m_stride + player
+    std::vector<std::uint8_t> m_flags;
+    std::vector<std::uint8_t> m_wins;
+    std::vector<std::uint8_t> m_losses;
+    std::vector<std::uint8_t> m_ties;
+};
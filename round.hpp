@@ -0,0 +1,81 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//two players paired in a round, by id
+struct Pairing
+{
+    std::int32_t player1 = -1;
+    std::int32_t player2 = -1; //-1 for a bye
+    bool reported = false; //set once the result is in, byes are reported when paired
+};
+
+//the pairings of one round of a Tournament
+class Round
+{
+public:
+    Round() = default;
+
+    explicit Round(std::vector<Pairing> pairings) : m_pairings(std::move(pairings)) {}
+
+    inline const std::vector<Pairing> &getPairings() const
+    {
+        return m_pairings;
+    }
+
+    inline std::size_t getNumPairings() const
+    {
+        return m_pairings.size();
+    }
+
+    inline const Pairing &getPairing(std::size_t index) const
+    {
+        return m_pairings[index];
+    }
+
+    inline void setReported(std::size_t index)
+    {
+        m_pairings[index].reported = true;
+    }
+
+    //true once every pairing has a result
+    inline bool isComplete() const
+    {
+        for (const auto &pairing : m_pairings)
+        {
+            if (!pairing.reported)
+                return false;
+        }
+        return true;
+    }
+
+private:
+    std::vector<Pairing> m_pairings;
+};
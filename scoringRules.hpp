@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "matchResult.hpp"
+
+#include <cstdint>
+
+//Points and limits of a match format, used by the Player score getters and ResultStore.
+//The presets below are constexpr, so code given a preset (see Player::updateHistory) has every value folded in,
+//while a custom format is read from its descriptor at run time.
+struct ScoringRules
+{
+    std::int32_t bestOf;           //most games one match can decide
+    std::uint32_t matchWinPoints;  //also the most a match can score, the base of the match win percentage
+    std::uint32_t matchTiePoints;
+    std::uint32_t matchLossPoints;
+    std::uint32_t gameWinPoints;   //also the most a game can score, the base of the game win percentage
+    std::uint32_t gameTiePoints;
+    std::uint32_t byeMatchPoints;
+    std::uint32_t byeGameWins;     //games a bye counts as won
+    double minimumWinPercentage;   //floor of the win percentages
+
+    constexpr std::uint32_t matchPoints(bool matchWin, bool matchTie) const
+    {
+        return matchWin ? matchWinPoints : (matchTie ? matchTiePoints : matchLossPoints);
+    }
+
+    constexpr std::uint32_t gamePoints(std::uint32_t wins, std::uint32_t ties) const
+    {
+        return (gameWinPoints * wins) + (gameTiePoints * ties);
+    }
+
+    constexpr std::uint32_t byeGamePoints() const
+    {
+        return gameWinPoints * byeGameWins;
+    }
+
+    //points of a stored result, byes included
+    constexpr std::uint32_t resultMatchPoints(const PackedMatchResult &result) const
+    {
+        return result.bye() ? byeMatchPoints : matchPoints(result.matchWin(), result.matchTie());
+    }
+
+    constexpr std::uint32_t resultGamePoints(const PackedMatchResult &result) const
+    {
+        return result.bye() ? byeGamePoints() : gamePoints(result.wins(), result.ties());
+    }
+
+    constexpr bool operator==(const ScoringRules &other) const
+    {
+        return bestOf == other.bestOf && matchWinPoints == other.matchWinPoints && matchTiePoints == other.matchTiePoints &&
+               matchLossPoints == other.matchLossPoints && gameWinPoints == other.gameWinPoints && gameTiePoints == other.gameTiePoints &&
+               byeMatchPoints == other.byeMatchPoints && byeGameWins == other.byeGameWins && minimumWinPercentage == other.minimumWinPercentage;
+    }
+
+    constexpr bool operator!=(const ScoringRules &other) const
+    {
+        return !(*this == other);
+    }
+};
+
+//Preset for best of BEST_OF matches: 3 points for a match win and 1 for a draw, 3 per game won and 1 per game drawn,
+//a bye is a match win with the games needed to win it, and win percentages are at least 0.33.
+template<std::int32_t BEST_OF>
+struct StandardScoring
+{
+    static constexpr ScoringRules rules()
+    {
+        return ScoringRules{BEST_OF, 3, 1, 0, 3, 1, 3, BEST_OF / 2 + 1, 0.33};
+    }
+};
+
+using BestOf1Scoring = StandardScoring<1>;
+using BestOf3Scoring = StandardScoring<3>;
+using BestOf5Scoring = StandardScoring<5>;
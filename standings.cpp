@@ -0,0 +1,189 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "standings.hpp"
+#include "opponentAverages.hpp"
+
+#include <algorithm>
+#include <array>
+
+void Standings::prepare(const std::vector<const PlayerRecord *> &players, const std::vector<const PlayerRecord *> &playersById, std::int32_t maxMatch)
+{
+    m_maxMatch = maxMatch;
+    m_entries.clear();
+    m_entries.reserve(players.size());
+    m_opponents.clear();
+
+    //every player's own scores come from the result store kernel in one pass, every player plays the same format
+    m_store.load(players);
+    if (!players.empty())
+        m_store.computeScores(m_scores, maxMatch, players.front()->getScoringRules());
+
+    //opponents are found by id, players dropped from the list are computed directly when met
+    std::vector<std::int32_t> index;
+
+    std::size_t numResults = 0;
+    for (const auto player : players)
+    {
+        const auto i = m_entries.size();
+        numResults += player->getMatchResults().size();
+        if (player->getId() >= 0)
+        {
+            if (static_cast<std::size_t>(player->getId()) >= index.size())
+                index.resize(player->getId() + 1, -1);
+            index[player->getId()] = static_cast<std::int32_t>(i);
+        }
+        m_entries.emplace_back();
+        auto &entry = m_entries.back();
+        entry.player = player;
+        entry.matchScore = static_cast<std::uint32_t>(m_scores.matchPoints[i]);
+        entry.gameScore = static_cast<std::uint32_t>(m_scores.gamePoints[i]);
+        entry.matchWinPercentage = m_scores.matchWinPercentage[i];
+        entry.gameWinPercentage = m_scores.gameWinPercentage[i];
+    }
+
+    m_opponents.reserve(numResults);
+    for (auto &entry : m_entries)
+    {
+        entry.firstOpponent = m_opponents.size();
+        const auto opponents = averageOpponents(entry.player->getMatchResults(), maxMatch, [this, &entry, &index, &playersById, maxMatch](const PackedMatchResult &result, double &matchWinPer, double &gameWinPer)
+                                                {
+                                                    StandingsOpponent opponent;
+                                                    const auto oppIndex = result.opponent() >= 0 && static_cast<std::size_t>(result.opponent()) < index.size() ? index[result.opponent()] : -1;
+                                                    if (oppIndex >= 0)
+                                                    {
+                                                        const auto &oppEntry = m_entries[oppIndex];
+                                                        opponent.matchScore = oppEntry.matchScore;
+                                                        matchWinPer = oppEntry.matchWinPercentage;
+                                                        gameWinPer = oppEntry.gameWinPercentage;
+                                                    }
+                                                    else
+                                                    {
+                                                        const auto dropped = result.opponent() >= 0 && static_cast<std::size_t>(result.opponent()) < playersById.size() ? playersById[result.opponent()] : nullptr;
+                                                        if (dropped == nullptr)
+                                                            return false;
+                                                        opponent.matchScore = dropped->getMatchScore(maxMatch);
+                                                        matchWinPer = dropped->getMatchWinPercentage(maxMatch);
+                                                        gameWinPer = dropped->getGameWinPercentage(maxMatch);
+                                                    }
+                                                    opponent.resultPoints = entry.player->getScoringRules().matchPoints(result.matchWin(), result.matchTie());
+                                                    m_opponents.push_back(opponent);
+                                                    return true;
+                                                });
+        entry.numOpponents = opponents.numOpponents;
+        entry.opponentMatchWinPercentage = opponents.matchWinPercentage;
+        entry.opponentGameWinPercentage = opponents.gameWinPercentage;
+    }
+}
+
+void Standings::rank()
+{
+    sortEntries();
+
+    for (std::size_t i = 0; i < m_entries.size(); i++)
+    {
+        if (i > 0 && m_entries[i].key == m_entries[i - 1].key)
+            m_entries[i].place = m_entries[i - 1].place;
+        else
+            m_entries[i].place = static_cast<std::int32_t>(i) + 1;
+    }
+}
+
+void Standings::sortEntries()
+{
+    constexpr std::uint32_t DIGIT_BITS = 8;
+    constexpr std::uint32_t NUM_BUCKETS = 1 << DIGIT_BITS;
+
+    const std::size_t count = m_entries.size();
+    std::vector<std::uint32_t> order(count);
+    std::vector<std::uint32_t> sorted(count);
+    for (std::size_t i = 0; i < count; i++)
+        order[i] = static_cast<std::uint32_t>(i);
+
+    //least significant digit first, digits are inverted so the highest keys come first
+    std::array<std::size_t, NUM_BUCKETS> buckets;
+    for (std::size_t value = TiebreakKey::SIZE; value-- > 0;)
+    {
+        for (std::uint32_t shift = 0; shift < 32; shift += DIGIT_BITS)
+        {
+            buckets.fill(0);
+            for (std::size_t i = 0; i < count; i++)
+                buckets[((~m_entries[i].key.values[value]) >> shift) & (NUM_BUCKETS - 1)]++;
+
+            //a digit shared by every key doesn't change the order
+            if (count == 0 || *std::max_element(buckets.begin(), buckets.end()) == count)
+                continue;
+
+            std::size_t start = 0;
+            for (auto &bucket : buckets)
+            {
+                const auto size = bucket;
+                bucket = start;
+                start += size;
+            }
+            for (auto index : order)
+                sorted[buckets[((~m_entries[index].key.values[value]) >> shift) & (NUM_BUCKETS - 1)]++] = index;
+            order.swap(sorted);
+        }
+    }
+
+    std::vector<StandingsEntry> entries;
+    entries.reserve(count);
+    for (auto index : order)
+        entries.push_back(std::move(m_entries[index]));
+    m_entries.swap(entries);
+}
+
+StandingsSnapshot::StandingsSnapshot(const Standings &standings, std::int32_t matchNum)
+{
+    m_matchNum = matchNum;
+    m_entries.reserve(standings.getEntries().size());
+    for (const auto &entry : standings.getEntries())
+    {
+        const auto id = entry.player->getId();
+        m_entries.emplace_back(StandingsSnapshotEntry{id, entry.place, entry.key});
+        if (id < 0)
+            continue;
+        if (static_cast<std::size_t>(id) >= m_placeById.size())
+            m_placeById.resize(id + 1, 0);
+        m_placeById[id] = entry.place;
+    }
+}
+
+std::int32_t StandingsSnapshot::getPlace(std::int32_t playerId) const
+{
+    if (playerId < 0 || static_cast<std::size_t>(playerId) >= m_placeById.size())
+        return 0;
+    return m_placeById[playerId];
+}
+
+std::int32_t StandingsSnapshot::getMovement(const StandingsSnapshot &earlier, std::int32_t playerId) const
+{
+    const auto place = getPlace(playerId);
+    const auto earlierPlace = earlier.getPlace(playerId);
+    if (place == 0 || earlierPlace == 0)
+        return 0;
+    return earlierPlace - place;
+}
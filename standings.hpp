@@ -0,0 +1,151 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "playerRecord.hpp"
+#include "resultStore.hpp"
+#include "tiebreakKey.hpp"
+
+#include <cstdint>
+#include <vector>
+
+struct StandingsEntry
+{
+    const PlayerRecord *player = nullptr;
+    std::int32_t place = 0; //1 based, players with equal tiebreak keys share a place
+    std::uint32_t matchScore = 0;
+    std::uint32_t gameScore = 0;
+    double matchWinPercentage = 0.0;
+    double gameWinPercentage = 0.0;
+    double opponentMatchWinPercentage = 0.0;
+    double opponentGameWinPercentage = 0.0;
+    std::size_t firstOpponent = 0; //this player's opponents are Standings::getOpponent(firstOpponent) onwards
+    std::size_t numOpponents = 0;
+    TiebreakKey key;
+};
+
+//what a tiebreak needs to know about one opponent of a player, byes have no opponent
+struct StandingsOpponent
+{
+    std::uint32_t matchScore = 0;
+    std::uint32_t resultPoints = 0; //match points the player earned against this opponent
+};
+
+//Computes the standings for a whole player list at once.
+//Comparing players one by one would recompute every opponent's win percentages on each comparison,
+//here the scores and win percentages of the whole list are computed once by ResultStore, then the opponents are gathered
+//in a single sweep over the results, the key of each player is built by the Tiebreaks chain (see tiebreaks.hpp)
+//and the entries are radix sorted on the keys.
+//Players with equal keys keep their order from the player list.
+//Part of swisscore, both Tournament and the Qt application (Match, MainWindow) rank players with it.
+class Standings
+{
+public:
+    Standings() = default;
+
+    //computes and sorts the standings of players, best first, counting matches up to maxMatch (-1 for all matches)
+    //opponents missing from players (dropped players) are looked up in playersById, indexed by id with nullptr for unused ids,
+    //opponents found in neither aren't counted
+    template <typename Tiebreaks>
+    void calculate(const std::vector<const PlayerRecord *> &players, const std::vector<const PlayerRecord *> &playersById, std::int32_t maxMatch = -1)
+    {
+        prepare(players, playersById, maxMatch);
+        for (auto &entry : m_entries)
+            entry.key = Tiebreaks::key(*this, entry);
+        rank();
+    }
+
+    inline const std::vector<StandingsEntry> &getEntries() const
+    {
+        return m_entries;
+    }
+
+    inline const StandingsOpponent &getOpponent(std::size_t index) const
+    {
+        return m_opponents[index];
+    }
+
+    //last match counted, -1 for all matches
+    inline std::int32_t getMaxMatch() const
+    {
+        return m_maxMatch;
+    }
+
+private:
+    //fills m_entries and m_opponents with everything but the keys
+    void prepare(const std::vector<const PlayerRecord *> &players, const std::vector<const PlayerRecord *> &playersById, std::int32_t maxMatch);
+
+    //sorts the entries by key and assigns places
+    void rank();
+
+    //stable LSD radix sort of m_entries by key, highest first
+    void sortEntries();
+
+    std::vector<StandingsEntry> m_entries;
+    std::vector<StandingsOpponent> m_opponents; //grouped by player, see StandingsEntry::firstOpponent
+    std::int32_t m_maxMatch = -1;
+    ResultStore m_store; //results of the player list, in list order
+    FieldScores m_scores;
+};
+
+struct StandingsSnapshotEntry
+{
+    std::int32_t playerId = -1;
+    std::int32_t place = 0;
+    TiebreakKey key;
+};
+
+//Standings frozen when a match is finalized, see Match::finalizeMatch.
+//Keeps only the order, places and tiebreak keys by player id, so the standings after any round and the rank
+//movement between rounds can be reported later without recomputing them.
+class StandingsSnapshot
+{
+public:
+    StandingsSnapshot(const Standings &standings, std::int32_t matchNum);
+
+    //last match counted
+    inline std::int32_t getMatchNum() const
+    {
+        return m_matchNum;
+    }
+
+    //best first
+    inline const std::vector<StandingsSnapshotEntry> &getEntries() const
+    {
+        return m_entries;
+    }
+
+    //place of the player, 0 if the player wasn't in these standings
+    std::int32_t getPlace(std::int32_t playerId) const;
+
+    //places gained since an earlier snapshot (negative if lost), 0 if the player is missing from either
+    std::int32_t getMovement(const StandingsSnapshot &earlier, std::int32_t playerId) const;
+
+private:
+    std::int32_t m_matchNum = -1;
+    std::vector<StandingsSnapshotEntry> m_entries;
+    std::vector<std::int32_t> m_placeById; //0 for ids not in the standings
+};
@@ -0,0 +1,155 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "standingsTree.hpp"
+
+#include <algorithm>
+
+namespace
+{
+//fixed priorities keep the tree shape (and so the timing) the same from run to run
+std::uint32_t priority(std::uint64_t index)
+{
+    index += 0x9e3779b97f4a7c15ULL;
+    index = (index ^ (index >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    index = (index ^ (index >> 27)) * 0x94d049bb133111ebULL;
+    return static_cast<std::uint32_t>(index ^ (index >> 31));
+}
+} // namespace
+
+void StandingsTree::reset(std::size_t numEntries)
+{
+    m_nodes.assign(numEntries, Node{});
+    for (std::size_t i = 0; i < numEntries; i++)
+        m_nodes[i].priority = priority(i);
+    m_root = NONE;
+}
+
+void StandingsTree::update(std::size_t index, const TiebreakKey &key)
+{
+    const auto node = static_cast<std::uint32_t>(index);
+    if (m_nodes[node].size != 0)
+    {
+        if (m_nodes[node].key == key)
+            return;
+        m_root = erase(m_root, node);
+    }
+    m_nodes[node].key = key;
+    m_nodes[node].left = NONE;
+    m_nodes[node].right = NONE;
+    m_nodes[node].size = 1;
+    m_root = insert(m_root, node);
+}
+
+std::vector<std::size_t> StandingsTree::top(std::size_t count) const
+{
+    std::vector<std::size_t> indices;
+    indices.reserve(std::min(count, size()));
+
+    //in order walk, stopping once count nodes are out
+    std::vector<std::uint32_t> stack;
+    auto node = m_root;
+    while (indices.size() < count && (node != NONE || !stack.empty()))
+    {
+        while (node != NONE)
+        {
+            stack.push_back(node);
+            node = m_nodes[node].left;
+        }
+        node = stack.back();
+        stack.pop_back();
+        indices.push_back(node);
+        node = m_nodes[node].right;
+    }
+    return indices;
+}
+
+std::uint32_t StandingsTree::insert(std::uint32_t root, std::uint32_t node)
+{
+    if (root == NONE)
+        return node;
+    if (m_nodes[node].priority > m_nodes[root].priority)
+    {
+        split(root, node, m_nodes[node].left, m_nodes[node].right);
+        updateSize(node);
+        return node;
+    }
+    if (ahead(node, root))
+        m_nodes[root].left = insert(m_nodes[root].left, node);
+    else
+        m_nodes[root].right = insert(m_nodes[root].right, node);
+    updateSize(root);
+    return root;
+}
+
+std::uint32_t StandingsTree::erase(std::uint32_t root, std::uint32_t node)
+{
+    if (root == node)
+        return merge(m_nodes[node].left, m_nodes[node].right);
+    if (ahead(node, root))
+        m_nodes[root].left = erase(m_nodes[root].left, node);
+    else
+        m_nodes[root].right = erase(m_nodes[root].right, node);
+    updateSize(root);
+    return root;
+}
+
+void StandingsTree::split(std::uint32_t root, std::uint32_t pivot, std::uint32_t &first, std::uint32_t &second)
+{
+    if (root == NONE)
+    {
+        first = NONE;
+        second = NONE;
+        return;
+    }
+    if (ahead(root, pivot))
+    {
+        split(m_nodes[root].right, pivot, m_nodes[root].right, second);
+        first = root;
+    }
+    else
+    {
+        split(m_nodes[root].left, pivot, first, m_nodes[root].left);
+        second = root;
+    }
+    updateSize(root);
+}
+
+std::uint32_t StandingsTree::merge(std::uint32_t first, std::uint32_t second)
+{
+    if (first == NONE)
+        return second;
+    if (second == NONE)
+        return first;
+    if (m_nodes[first].priority > m_nodes[second].priority)
+    {
+        m_nodes[first].right = merge(m_nodes[first].right, second);
+        updateSize(first);
+        return first;
+    }
+    m_nodes[second].left = merge(first, m_nodes[second].left);
+    updateSize(second);
+    return second;
+}
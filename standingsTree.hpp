@@ -0,0 +1,96 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "tiebreakKey.hpp"
+
+#include <cstdint>
+#include <vector>
+
+//Order statistics tree (a treap) over the entries of LiveStandings, best tiebreak key first, equal keys by entry index.
+//Moving an entry after its key changed is O(log n) and reading the top k entries is O(k + log n),
+//so live standings never need a full sort.
+class StandingsTree
+{
+public:
+    StandingsTree() = default;
+
+    //empties the tree and makes room for entries 0 to numEntries - 1
+    void reset(std::size_t numEntries);
+
+    //inserts the entry, or moves it if it's already in the tree
+    void update(std::size_t index, const TiebreakKey &key);
+
+    inline std::size_t size() const
+    {
+        return m_root == NONE ? 0 : m_nodes[m_root].size;
+    }
+
+    //indices of the first count entries, best first
+    std::vector<std::size_t> top(std::size_t count) const;
+
+private:
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+    struct Node
+    {
+        TiebreakKey key;
+        std::uint32_t priority = 0;
+        std::uint32_t left = NONE;
+        std::uint32_t right = NONE;
+        std::uint32_t size = 0; //nodes in this subtree, 0 if not in the tree
+    };
+
+    //true if node a is placed ahead of node b
+    inline bool ahead(std::uint32_t a, std::uint32_t b) const
+    {
+        if (m_nodes[a].key != m_nodes[b].key)
+            return m_nodes[b].key < m_nodes[a].key;
+        return a < b;
+    }
+
+    inline std::uint32_t subtreeSize(std::uint32_t node) const
+    {
+        return node == NONE ? 0 : m_nodes[node].size;
+    }
+
+    inline void updateSize(std::uint32_t node)
+    {
+        m_nodes[node].size = subtreeSize(m_nodes[node].left) + subtreeSize(m_nodes[node].right) + 1;
+    }
+
+    std::uint32_t insert(std::uint32_t root, std::uint32_t node);
+    std::uint32_t erase(std::uint32_t root, std::uint32_t node);
+
+    //splits root into the nodes ahead of pivot (first) and the rest (second)
+    void split(std::uint32_t root, std::uint32_t pivot, std::uint32_t &first, std::uint32_t &second);
+
+    //joins two trees, every node of first placed ahead of every node of second
+    std::uint32_t merge(std::uint32_t first, std::uint32_t second);
+
+    std::vector<Node> m_nodes; //indexed by entry
+    std::uint32_t m_root = NONE;
+};
@@ -0,0 +1,162 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pairingSearch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//checks bracketPairing pairs every player exactly once, round after round of whole tournaments,
+//with and without the cache and worker threads
+
+namespace
+{
+constexpr std::int32_t NUM_SEEDS = 4;
+
+//players sorted by score after matchNum, the order bracketPairing expects
+std::vector<const PlayerRecord *> sortedField(const std::vector<PlayerRecord> &records, std::int32_t matchNum)
+{
+    std::vector<const PlayerRecord *> players;
+    for (const auto &record : records)
+        players.push_back(&record);
+    std::stable_sort(players.begin(), players.end(), [matchNum](const PlayerRecord *p1, const PlayerRecord *p2)
+                     { return p1->getMatchScore(matchNum) > p2->getMatchScore(matchNum); });
+    return players;
+}
+
+//true if every player is in exactly one pairing and only an odd field has a bye
+bool complete(const std::vector<std::pair<std::int32_t, std::int32_t>> &pairs, std::int32_t numPlayers)
+{
+    std::vector<std::int32_t> seen(numPlayers, 0);
+    std::int32_t byes = 0;
+    for (const auto &pair : pairs)
+    {
+        seen[pair.first]++;
+        if (pair.second >= 0)
+            seen[pair.second]++;
+        else
+            byes++;
+    }
+    return byes == (numPlayers & 1) && std::all_of(seen.begin(), seen.end(), [](std::int32_t count)
+                                                   { return count == 1; });
+}
+
+//plays numRounds rounds paired by bracketPairing, returns false at the first round that isn't paired
+bool playTournament(std::int32_t numPlayers, std::int32_t numRounds, std::uint32_t seed, bool useCache, std::int32_t numThreads)
+{
+    std::mt19937 rng(seed);
+    ResultMatrix results;
+    std::vector<PlayerRecord> records;
+    records.reserve(numPlayers);
+    for (std::int32_t i = 0; i < numPlayers; i++)
+        records.emplace_back("p" + std::to_string(i), i, &results);
+
+    PairingCache cache;
+    for (std::int32_t round = 0; round < numRounds; round++)
+    {
+        const auto players = sortedField(records, round - 1);
+        cache.reset();
+        std::vector<std::pair<std::int32_t, std::int32_t>> pairs;
+        if (!bracketPairing(players, round - 1, useCache ? &cache : nullptr, numThreads, true, pairs) || !complete(pairs, numPlayers))
+        {
+            std::cerr << numPlayers << " players, seed " << seed << (useCache ? ", cached" : "") << ", " << numThreads << " threads: round " << round
+                      << " not paired\n";
+            return false;
+        }
+        for (const auto &pair : pairs)
+        {
+            MatchResult result;
+            if (pair.second < 0)
+            {
+                result.bye = true;
+                result.wins = 2;
+                result.matchWin = true;
+                records[players[pair.first]->getId()].setMatchResult(round, result);
+                continue;
+            }
+            result.wins = rng() % 3;
+            result.losses = result.wins == 2 ? rng() % 2 : 2;
+            result.matchWin = result.wins > result.losses;
+            result.opponent = players[pair.second]->getId();
+            records[players[pair.first]->getId()].setMatchResult(round, result);
+            std::swap(result.wins, result.losses);
+            result.matchWin = result.wins > result.losses;
+            result.opponent = players[pair.first]->getId();
+            records[players[pair.second]->getId()].setMatchResult(round, result);
+        }
+    }
+    return true;
+}
+
+//the bottom bracket is a single player: p0 beat p1 and p2 had the bye, so p1 is left on its own
+bool loneBottomPlayer()
+{
+    ResultMatrix results;
+    std::vector<PlayerRecord> records;
+    for (std::int32_t i = 0; i < 3; i++)
+        records.emplace_back("p" + std::to_string(i), i, &results);
+    MatchResult result;
+    result.wins = 2;
+    result.matchWin = true;
+    result.opponent = 1;
+    records[0].setMatchResult(0, result);
+    result.wins = 0;
+    result.losses = 2;
+    result.matchWin = false;
+    result.opponent = 0;
+    records[1].setMatchResult(0, result);
+    MatchResult bye;
+    bye.bye = true;
+    bye.wins = 2;
+    bye.matchWin = true;
+    records[2].setMatchResult(0, bye);
+
+    const std::vector<const PlayerRecord *> players = {&records[0], &records[2], &records[1]};
+    std::vector<std::pair<std::int32_t, std::int32_t>> pairs;
+    if (!bracketPairing(players, 0, nullptr, 1, true, pairs) || !complete(pairs, 3))
+    {
+        std::cerr << "lone bottom player not paired\n";
+        return false;
+    }
+    return true;
+}
+} // namespace
+
+int main()
+{
+    bool ok = loneBottomPlayer();
+    for (const auto numPlayers : {5, 17, 33})
+    {
+        for (std::uint32_t seed = 0; seed < NUM_SEEDS; seed++)
+        {
+            ok = playTournament(numPlayers, 10, seed, false, 1) && ok;
+            ok = playTournament(numPlayers, 10, seed, true, 1) && ok;
+            ok = playTournament(numPlayers, 10, seed, true, 4) && ok;
+        }
+    }
+    return ok ? 0 : 1;
+}
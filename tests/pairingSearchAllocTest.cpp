@@ -0,0 +1,203 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pairingSearch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+
+//checks PairingSearch::run never allocates once the search is constructed, so no search node allocates either,
+//and that the workers of runParallel search without allocating
+
+namespace
+{
+constexpr std::int32_t NUM_PLAYERS = 512;
+constexpr std::int32_t NUM_ROUNDS = 9; //enough for the search with score differences to run into its deadline
+
+std::atomic<std::uint64_t> g_allocations{0};
+std::atomic<std::uint64_t> g_workerAllocations{0}; //allocations made on threads other than the main thread
+std::thread::id g_mainThread;
+
+//players sorted by score after matchNum, the order PairingSearch expects
+std::vector<const PlayerRecord *> sortedField(const std::vector<PlayerRecord> &records, std::int32_t matchNum)
+{
+    std::vector<const PlayerRecord *> players;
+    for (const auto &record : records)
+        players.push_back(&record);
+    std::stable_sort(players.begin(), players.end(), [matchNum](const PlayerRecord *p1, const PlayerRecord *p2)
+                     { return p1->getMatchScore(matchNum) > p2->getMatchScore(matchNum); });
+    return players;
+}
+
+//runs the search with allocations counted, returns false if it allocated or found nothing
+bool countedRun(PairingSearch &search, const char *name)
+{
+    const auto before = g_allocations.load();
+    const bool found = search.run();
+    const auto allocations = g_allocations.load() - before;
+    if (!found)
+    {
+        std::cerr << name << ": no pairing found\n";
+        return false;
+    }
+    if (allocations != 0)
+    {
+        std::cerr << name << ": " << allocations << " allocations during the search\n";
+        return false;
+    }
+    return true;
+}
+
+//runs the search on threads, returns false if a worker thread allocated or nothing was found
+//the calling thread collects the branches, copies the workers and starts the threads, so only the other workers are counted,
+//they run the same search as the worker on the calling thread
+bool countedRunParallel(PairingSearch &search, std::int32_t numThreads, bool deterministic, const char *name)
+{
+    const auto before = g_workerAllocations.load();
+    const bool found = search.runParallel(PAIRING_NO_COST_LIMIT, numThreads, deterministic);
+    const auto allocations = g_workerAllocations.load() - before;
+    if (!found)
+    {
+        std::cerr << name << ": no pairing found\n";
+        return false;
+    }
+    if (allocations != 0)
+    {
+        std::cerr << name << ": " << allocations << " allocations on worker threads\n";
+        return false;
+    }
+    return true;
+}
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    g_allocations++;
+    if (std::this_thread::get_id() != g_mainThread)
+        g_workerAllocations++;
+    if (void *memory = std::malloc(size == 0 ? 1 : size))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+int main()
+{
+    g_mainThread = std::this_thread::get_id();
+    std::mt19937 rng(5);
+    ResultMatrix results;
+    std::vector<PlayerRecord> records;
+    records.reserve(NUM_PLAYERS);
+    for (std::int32_t i = 0; i < NUM_PLAYERS; i++)
+        records.emplace_back("p" + std::to_string(i), i, &results);
+
+    //play some rounds paired by the search itself, so the last search has scores, rematches to avoid and byes to spread
+    PairingCache cache;
+    for (std::int32_t round = 0; round < NUM_ROUNDS; round++)
+    {
+        const auto players = sortedField(records, round - 1);
+        cache.reset();
+        PairingSearch search(players, round - 1, &cache);
+        if (!search.run())
+        {
+            std::cerr << "round " << round << ": no pairing found\n";
+            return 1;
+        }
+        for (const auto &pair : search.getPairs())
+        {
+            MatchResult result;
+            result.played = true;
+            if (pair.second < 0)
+            {
+                result.bye = true;
+                result.wins = 2;
+                result.matchWin = true;
+                records[players[pair.first]->getId()].setMatchResult(round, result);
+                continue;
+            }
+            result.wins = rng() % 3;
+            result.losses = result.wins == 2 ? rng() % 2 : 2;
+            result.matchWin = result.wins > result.losses;
+            result.opponent = players[pair.second]->getId();
+            records[players[pair.first]->getId()].setMatchResult(round, result);
+            std::swap(result.wins, result.losses);
+            result.matchWin = result.wins > result.losses;
+            result.opponent = players[pair.first]->getId();
+            records[players[pair.second]->getId()].setMatchResult(round, result);
+        }
+    }
+
+    const auto players = sortedField(records, NUM_ROUNDS - 1);
+    bool ok = true;
+
+    PairingSearch plain(players, NUM_ROUNDS - 1, nullptr);
+    ok = countedRun(plain, "search") && ok;
+
+    cache.reset();
+    PairingSearch cached(players, NUM_ROUNDS - 1, &cache);
+    ok = countedRun(cached, "cached search") && ok;
+
+    //counting score differences the search can't prove its best pairing, so it backtracks through nodes until the deadline
+    cache.reset();
+    PairingSearch floating(players, NUM_ROUNDS - 1, &cache);
+    floating.setFloatCost(PAIRING_FLOAT_COST);
+    floating.setDeadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(200));
+    ok = countedRun(floating, "search with score differences") && ok;
+
+    //the backtracking above comes back to sets of players it already priced, the cache has to cut some of them off
+    if (cache.hits() == 0)
+    {
+        std::cerr << "search with score differences: the cache cut off no set of players (" << cache.misses() << " misses)\n";
+        ok = false;
+    }
+
+    cache.reset();
+    PairingSearch parallel(players, NUM_ROUNDS - 1, &cache);
+    ok = countedRunParallel(parallel, 4, true, "parallel search") && ok;
+
+    cache.reset();
+    PairingSearch floatingParallel(players, NUM_ROUNDS - 1, &cache);
+    floatingParallel.setFloatCost(PAIRING_FLOAT_COST);
+    floatingParallel.setDeadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(200));
+    ok = countedRunParallel(floatingParallel, 4, false, "parallel search with score differences") && ok;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "pairingSearch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//checks PairingSearch::run finds the lowest cost pairing, against every pairing of small fields
+
+namespace
+{
+constexpr std::int32_t MAX_PLAYERS = 9;
+constexpr std::int32_t NUM_ROUNDS = 12;
+constexpr std::int32_t NUM_SEEDS = 10;
+
+//players sorted by score after matchNum, the order PairingSearch expects
+std::vector<const PlayerRecord *> sortedField(const std::vector<PlayerRecord> &records, std::int32_t matchNum)
+{
+    std::vector<const PlayerRecord *> players;
+    for (const auto &record : records)
+        players.push_back(&record);
+    std::stable_sort(players.begin(), players.end(), [matchNum](const PlayerRecord *p1, const PlayerRecord *p2)
+                     { return p1->getMatchScore(matchNum) > p2->getMatchScore(matchNum); });
+    return players;
+}
+
+//cost of the cheapest pairing of the players not yet paired, tried one by one
+std::uint64_t bruteForce(const std::vector<const PlayerRecord *> &players, std::vector<bool> &paired, std::int32_t matchNum, std::uint64_t floatCost, bool byeGiven)
+{
+    const auto numPlayers = static_cast<std::int32_t>(players.size());
+    std::int32_t p1 = 0;
+    while (p1 < numPlayers && paired[p1])
+        p1++;
+    if (p1 == numPlayers)
+        return 0;
+
+    const auto &player1 = *players[p1];
+    paired[p1] = true;
+    std::uint64_t best = PAIRING_NO_COST_LIMIT;
+    if (!byeGiven && (numPlayers & 1) == 1)
+    {
+        const auto rest = bruteForce(players, paired, matchNum, floatCost, true);
+        if (rest != PAIRING_NO_COST_LIMIT)
+            best = std::min(best, rest + static_cast<std::uint64_t>(player1.receivedByes(matchNum)) * PAIRING_REPEAT_BYE_COST);
+    }
+    for (auto p2 = p1 + 1; p2 < numPlayers; p2++)
+    {
+        if (paired[p2])
+            continue;
+        const auto &player2 = *players[p2];
+        const auto timesPlayed = std::max(player1.timesPlayed(player2.getId(), matchNum), player2.timesPlayed(player1.getId(), matchNum));
+        auto cost = static_cast<std::uint64_t>(timesPlayed) * PAIRING_REMATCH_COST;
+        cost += static_cast<std::uint64_t>(std::abs(static_cast<std::int64_t>(player1.getMatchScore(matchNum)) - player2.getMatchScore(matchNum))) * floatCost;
+        paired[p2] = true;
+        const auto rest = bruteForce(players, paired, matchNum, floatCost, byeGiven);
+        paired[p2] = false;
+        if (rest != PAIRING_NO_COST_LIMIT)
+            best = std::min(best, rest + cost);
+    }
+    paired[p1] = false;
+    return best;
+}
+
+//runs the search on players and compares it to the brute force cost, returns false on a mismatch
+bool check(const std::vector<const PlayerRecord *> &players, std::int32_t matchNum, std::uint64_t floatCost, PairingCache *cache, const char *name)
+{
+    std::vector<bool> paired(players.size(), false);
+    const auto expected = bruteForce(players, paired, matchNum, floatCost, false);
+
+    PairingSearch search(players, matchNum, cache);
+    search.setFloatCost(floatCost);
+    const bool found = search.run();
+    if (!found || search.getCost() != expected)
+    {
+        std::cerr << name << ", " << players.size() << " players after match " << matchNum << ": cost " << (found ? search.getCost() : PAIRING_NO_COST_LIMIT)
+                  << " instead of " << expected << "\n";
+        return false;
+    }
+    return true;
+}
+} // namespace
+
+int main()
+{
+    bool ok = true;
+    for (std::int32_t numPlayers = 1; numPlayers <= MAX_PLAYERS; numPlayers++)
+    {
+        for (std::int32_t seed = 0; seed < NUM_SEEDS; seed++)
+        {
+            std::mt19937 rng(seed);
+            ResultMatrix results;
+            std::vector<PlayerRecord> records;
+            records.reserve(numPlayers);
+            for (std::int32_t i = 0; i < numPlayers; i++)
+                records.emplace_back("p" + std::to_string(i), i, &results);
+
+            //each round is checked, then played as paired, so later rounds have rematches and repeat byes to avoid
+            PairingCache cache;
+            for (std::int32_t round = 0; round < NUM_ROUNDS && ok; round++)
+            {
+                const auto players = sortedField(records, round - 1);
+                ok = check(players, round - 1, 0, nullptr, "search") && ok;
+                cache.reset();
+                ok = check(players, round - 1, 0, &cache, "cached search") && ok;
+                ok = check(players, round - 1, PAIRING_FLOAT_COST, nullptr, "search with score differences") && ok;
+
+                PairingSearch search(players, round - 1, nullptr);
+                if (!search.run())
+                    break;
+                for (const auto &pair : search.getPairs())
+                {
+                    MatchResult result;
+                    if (pair.second < 0)
+                    {
+                        result.bye = true;
+                        result.wins = 2;
+                        result.matchWin = true;
+                        records[players[pair.first]->getId()].setMatchResult(round, result);
+                        continue;
+                    }
+                    result.wins = rng() % 3;
+                    result.losses = result.wins == 2 ? rng() % 2 : 2;
+                    result.matchWin = result.wins > result.losses;
+                    result.opponent = players[pair.second]->getId();
+                    records[players[pair.first]->getId()].setMatchResult(round, result);
+                    std::swap(result.wins, result.losses);
+                    result.matchWin = result.wins > result.losses;
+                    result.opponent = players[pair.first]->getId();
+                    records[players[pair.second]->getId()].setMatchResult(round, result);
+                }
+            }
+        }
+    }
+    return ok ? 0 : 1;
+}
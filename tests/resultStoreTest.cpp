@@ -0,0 +1,141 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "resultStore.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//checks ResultStore::computeScores gives the same totals and percentages as the PlayerRecord getters,
+//loaded from the records and from the ResultMatrix they keep their results in
+
+namespace
+{
+constexpr std::int32_t NUM_PLAYERS = 1001; //not a multiple of any vector width, so the padding is covered
+constexpr std::int32_t NUM_ROUNDS = 9;
+
+bool same(double a, double b)
+{
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+//returns the number of players whose scores differ from their record, the first one is reported if report is set
+std::int32_t compare(const ResultStore &store, std::vector<PlayerRecord> &records, const ScoringRules &rules, std::int32_t maxMatch, bool report)
+{
+    for (auto &record : records)
+        record.setScoringRules(rules);
+
+    FieldScores scores;
+    store.computeScores(scores, maxMatch, rules);
+
+    std::int32_t bad = 0;
+    for (std::size_t i = 0; i < records.size(); i++)
+    {
+        const auto &record = records[i];
+        if (scores.matchPoints[i] != static_cast<std::int32_t>(record.getMatchScore(maxMatch)) ||
+            scores.gamePoints[i] != static_cast<std::int32_t>(record.getGameScore(maxMatch)) ||
+            scores.byes[i] != record.receivedByes(maxMatch) ||
+            !same(scores.matchWinPercentage[i], record.getMatchWinPercentage(maxMatch)) ||
+            !same(scores.gameWinPercentage[i], record.getGameWinPercentage(maxMatch)))
+        {
+            if (report && bad == 0)
+                std::cerr << "player " << i << " after match " << maxMatch << ": match points " << scores.matchPoints[i] << " vs " << record.getMatchScore(maxMatch)
+                          << ", game points " << scores.gamePoints[i] << " vs " << record.getGameScore(maxMatch) << "\n";
+            bad++;
+        }
+    }
+    return bad;
+}
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(11);
+    ResultMatrix matrix;
+    std::vector<PlayerRecord> records;
+    records.reserve(NUM_PLAYERS);
+    for (std::int32_t i = 0; i < NUM_PLAYERS; i++)
+        records.emplace_back("p" + std::to_string(i), i, &matrix);
+
+    //random results, including unplayed rounds, byes and results that were entered and then taken back
+    for (std::int32_t round = 0; round < NUM_ROUNDS; round++)
+    {
+        for (std::int32_t i = 0; i < NUM_PLAYERS; i++)
+        {
+            const auto kind = rng() % 10;
+            if (kind == 0)
+                continue;
+            MatchResult result;
+            result.played = true;
+            if (kind == 1)
+            {
+                result.bye = true;
+                result.wins = 2;
+                result.matchWin = true;
+            }
+            else
+            {
+                result.wins = rng() % 3;
+                result.losses = rng() % 3;
+                result.ties = rng() % 2;
+                result.matchWin = result.wins > result.losses;
+                result.matchTie = result.wins == result.losses;
+                result.opponent = (i + 1) % NUM_PLAYERS;
+            }
+            records[i].setMatchResult(round, result);
+            if (kind == 2)
+                records[i].setMatchPlayed(round, false);
+        }
+    }
+
+    std::vector<const PlayerRecord *> players;
+    for (const auto &record : records)
+        players.push_back(&record);
+    ResultStore fromRecords;
+    fromRecords.load(players);
+    ResultStore fromMatrix;
+    fromMatrix.load(matrix);
+
+    const ScoringRules rules[] = {BestOf3Scoring::rules(), BestOf1Scoring::rules(), BestOf5Scoring::rules(),
+                                  ScoringRules{3, 2, 1, 0, 2, 1, 2, 1, 0.25}, ScoringRules{5, 10, 4, 1, 100, 7, 9, 3, 0.1}};
+    std::int32_t bad = 0;
+    for (const auto &rule : rules)
+    {
+        for (std::int32_t maxMatch = -1; maxMatch <= NUM_ROUNDS; maxMatch++)
+        {
+            bad += compare(fromRecords, records, rule, maxMatch, bad == 0);
+            bad += compare(fromMatrix, records, rule, maxMatch, bad == 0);
+        }
+    }
+
+    if (bad > 0)
+    {
+        std::cerr << bad << " scores differ from the records\n";
+        return 1;
+    }
+    return 0;
+}
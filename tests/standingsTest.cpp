@@ -0,0 +1,183 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tiebreaks.hpp"
+#include "tournament.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//checks the batch Standings against tiebreakers computed one player at a time from the records,
+//and that Tournament::getStandings ranks by them
+
+namespace
+{
+//the MtG key of one player from its own getters, the way a comparator would compute it
+TiebreakKey mtgKey(const Tournament &tourney, std::int32_t id, std::int32_t maxMatch)
+{
+    const auto player = tourney.getPlayer(id);
+    const auto opponents = tourney.getOpponentAverages(id, maxMatch);
+    return TiebreakKey(player->getMatchScore(maxMatch), player->getGameScore(maxMatch), player->getMatchWinPercentage(maxMatch), player->getGameWinPercentage(maxMatch),
+                       opponents.matchWinPercentage, opponents.gameWinPercentage);
+}
+
+//Buchholz and Sonneborn-Berger of one player, summed over its results
+void chessSums(const Tournament &tourney, std::int32_t id, std::int32_t maxMatch, std::uint32_t &buchholz, std::uint32_t &sonnebornBerger)
+{
+    const auto player = tourney.getPlayer(id);
+    buchholz = 0;
+    sonnebornBerger = 0;
+    for (std::int32_t i = 0; i <= maxMatch; i++)
+    {
+        const auto result = player->getMatchResult(i);
+        if (!result.played || result.bye)
+            continue;
+        const auto score = tourney.getPlayer(result.opponent)->getMatchScore(maxMatch);
+        buchholz += score;
+        sonnebornBerger += score * tourney.getScoringRules().matchPoints(result.matchWin, result.matchTie);
+    }
+}
+
+//plays numRounds rounds with some drawn matches, dropping a player every other round
+void play(Tournament &tourney, std::int32_t numPlayers, std::int32_t numRounds, std::mt19937 &rng)
+{
+    for (std::int32_t i = 0; i < numPlayers; i++)
+        tourney.addPlayer("p" + std::to_string(i));
+
+    for (std::int32_t round = 0; round < numRounds; round++)
+    {
+        if (round % 2 == 1)
+            tourney.dropPlayer(static_cast<std::int32_t>(rng() % numPlayers));
+        if (!tourney.pairNextRound())
+            return;
+        const auto &pairings = tourney.getRounds().back().getPairings();
+        for (std::size_t i = 0; i < pairings.size(); i++)
+        {
+            if (pairings[i].player2 < 0)
+                continue;
+            if (rng() % 5 == 0)
+            {
+                tourney.setResult(round, i, 1, 1, 1);
+                continue;
+            }
+            const auto wins = rng() % 3;
+            tourney.setResult(round, i, wins, wins == 2 ? rng() % 2 : 2, 0);
+        }
+    }
+}
+
+bool check(std::int32_t numPlayers, std::int32_t numRounds, std::uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    Tournament tourney(BestOf3Scoring::rules(), seed);
+    play(tourney, numPlayers, numRounds, rng);
+
+    std::vector<const PlayerRecord *> everyone;
+    std::vector<const PlayerRecord *> active;
+    for (std::int32_t id = 0; id < numPlayers; id++)
+    {
+        everyone.push_back(tourney.getPlayer(id));
+        if (tourney.isActive(id))
+            active.push_back(tourney.getPlayer(id));
+    }
+
+    for (std::int32_t maxMatch = 0; maxMatch < numRounds; maxMatch++)
+    {
+        //equal keys keep id order
+        std::vector<TiebreakKey> keys;
+        std::vector<std::int32_t> expected;
+        for (std::int32_t id = 0; id < numPlayers; id++)
+        {
+            keys.push_back(mtgKey(tourney, id, maxMatch));
+            expected.push_back(id);
+        }
+        std::stable_sort(expected.begin(), expected.end(), [&keys](std::int32_t a, std::int32_t b)
+                         { return keys[b] < keys[a]; });
+        if (tourney.getStandings(maxMatch) != expected)
+        {
+            std::cerr << numPlayers << " players, seed " << seed << ": tournament standings after match " << maxMatch << " differ\n";
+            return false;
+        }
+
+        //only the active players are ranked, their dropped opponents still count
+        Standings mtg;
+        mtg.calculate<MtgTiebreaks>(active, everyone, maxMatch);
+        Standings chess;
+        chess.calculate<ChessTiebreaks>(active, everyone, maxMatch);
+        for (const auto standings : {&mtg, &chess})
+        {
+            const auto &entries = standings->getEntries();
+            if (entries.size() != active.size())
+            {
+                std::cerr << numPlayers << " players, seed " << seed << ": " << entries.size() << " entries for " << active.size() << " players\n";
+                return false;
+            }
+            for (std::size_t i = 0; i < entries.size(); i++)
+            {
+                const bool tied = i > 0 && entries[i].key == entries[i - 1].key;
+                if ((i > 0 && entries[i - 1].key < entries[i].key) || entries[i].place != (tied ? entries[i - 1].place : static_cast<std::int32_t>(i) + 1))
+                {
+                    std::cerr << numPlayers << " players, seed " << seed << ": standings after match " << maxMatch << " out of order at " << i << "\n";
+                    return false;
+                }
+            }
+        }
+        for (const auto &entry : mtg.getEntries())
+        {
+            if (entry.key != keys[entry.player->getId()])
+            {
+                std::cerr << numPlayers << " players, seed " << seed << ": MtG key of player " << entry.player->getId() << " after match " << maxMatch << " differs\n";
+                return false;
+            }
+        }
+        for (const auto &entry : chess.getEntries())
+        {
+            std::uint32_t buchholz = 0;
+            std::uint32_t sonnebornBerger = 0;
+            chessSums(tourney, entry.player->getId(), maxMatch, buchholz, sonnebornBerger);
+            if (entry.key.values[TiebreakKey::BUCHHOLZ] != buchholz || entry.key.values[TiebreakKey::SONNEBORN_BERGER] != sonnebornBerger)
+            {
+                std::cerr << numPlayers << " players, seed " << seed << ": chess tiebreaks of player " << entry.player->getId() << " after match " << maxMatch << " differ\n";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+} // namespace
+
+int main()
+{
+    bool ok = true;
+    for (std::uint32_t seed = 0; seed < 5; seed++)
+    {
+        ok = check(9, 4, seed) && ok;
+        ok = check(32, 6, seed) && ok;
+        ok = check(129, 8, seed) && ok;
+    }
+    return ok ? 0 : 1;
+}
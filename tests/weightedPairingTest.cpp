@@ -0,0 +1,131 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "fieldPairing.hpp"
+#include "tournament.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//checks weightedPairing avoids rematches and repeated byes whenever the field allows it,
+//including when the only way out is an opponent outside the first window
+
+namespace
+{
+//number of positions paired with an opponent they played or given a bye they already had
+std::int32_t penalized(const std::vector<std::int32_t> &mates, const std::vector<std::int64_t> &byes, const std::vector<std::vector<std::int32_t>> &played)
+{
+    const auto numPlayers = static_cast<std::int32_t>(mates.size());
+    std::int32_t count = 0;
+    for (std::int32_t i = 0; i < numPlayers; i++)
+    {
+        if (mates[i] == numPlayers)
+            count += byes[i] > 0 ? 1 : 0;
+        else if (mates[i] > i)
+            count += played[i][mates[i]] > 0 ? 1 : 0;
+    }
+    return count;
+}
+
+//everyone has played every player within PAIRING_WINDOW places, so the first window can only pair rematches
+//and every position but the top one already had a bye
+bool outsideWindow()
+{
+    constexpr std::int32_t numPlayers = 6 * PAIRING_WINDOW + 1;
+    std::vector<std::int64_t> scores(numPlayers);
+    std::vector<std::int64_t> byes(numPlayers, 1);
+    byes[0] = 0;
+    std::vector<std::vector<std::int32_t>> played(numPlayers, std::vector<std::int32_t>(numPlayers, 0));
+    for (std::int32_t i = 0; i < numPlayers; i++)
+    {
+        scores[i] = numPlayers - i;
+        for (std::int32_t j = 0; j < numPlayers; j++)
+            played[i][j] = i != j && std::abs(i - j) <= PAIRING_WINDOW ? 1 : 0;
+    }
+
+    const auto mates = weightedPairing(scores, byes, [&played](std::int32_t i, std::int32_t j)
+                                       { return played[i][j]; });
+    if (mates.size() != static_cast<std::size_t>(numPlayers) || penalized(mates, byes, played) > 0)
+    {
+        std::cerr << "rematch or repeated bye with a free pairing outside the window\n";
+        return false;
+    }
+    return true;
+}
+
+//plays a whole tournament, few enough rounds that a pairing without rematches or repeated byes always exists
+bool tournament(std::int32_t numPlayers, std::int32_t numRounds, std::uint64_t seed)
+{
+    std::mt19937 rng(static_cast<std::uint32_t>(seed));
+    Tournament tourney(BestOf3Scoring::rules(), seed);
+    for (std::int32_t i = 0; i < numPlayers; i++)
+        tourney.addPlayer("p" + std::to_string(i));
+
+    for (std::int32_t round = 0; round < numRounds; round++)
+    {
+        if (!tourney.pairNextRound())
+        {
+            std::cerr << numPlayers << " players, seed " << seed << ": round " << round << " not paired\n";
+            return false;
+        }
+        const auto &pairings = tourney.getRounds().back().getPairings();
+        for (std::size_t i = 0; i < pairings.size(); i++)
+        {
+            if (pairings[i].player2 < 0)
+                continue;
+            const auto wins = rng() % 3;
+            tourney.setResult(round, i, wins, wins == 2 ? rng() % 2 : 2, 0);
+        }
+    }
+
+    for (std::int32_t id = 0; id < numPlayers; id++)
+    {
+        const auto player = tourney.getPlayer(id);
+        bool rematch = false;
+        for (std::int32_t opp = 0; opp < numPlayers; opp++)
+            rematch = rematch || player->timesPlayed(opp) > 1;
+        if (rematch || player->receivedByes() > 1)
+        {
+            std::cerr << numPlayers << " players, seed " << seed << ": player " << id << " has a rematch or a repeated bye\n";
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+int main()
+{
+    bool ok = outsideWindow();
+    for (std::uint64_t seed = 0; seed < 5; seed++)
+    {
+        ok = tournament(21, 6, seed) && ok;
+        ok = tournament(64, 8, seed) && ok;
+        ok = tournament(101, 9, seed) && ok;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,42 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "tiebreakKey.hpp"
+
+#include <cmath>
+
+TiebreakKey::TiebreakKey(std::uint32_t matchScore, std::uint32_t gameScore, double matchWinPer, double gameWinPer, double oppMatchWinPer, double oppGameWinPer)
+{
+    values = {matchScore, gameScore, fixedPoint(matchWinPer), fixedPoint(gameWinPer), fixedPoint(oppMatchWinPer), fixedPoint(oppGameWinPer)};
+}
+
+std::uint32_t TiebreakKey::fixedPoint(double percentage)
+{
+    if (!(percentage > 0.0))
+        return 0;
+    if (percentage >= 1.0)
+        return UINT32_MAX;
+    return static_cast<std::uint32_t>(std::llround(percentage * static_cast<double>(UINT32_MAX)));
+}
@@ -0,0 +1,87 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+//Tiebreakers packed into integers, most significant first: match score, game score, match win percentage,
+//game win percentage, opponent match win percentage, opponent game win percentage.
+//Percentages are stored as fixed point fractions of 2^32 - 1, so keys compare exactly and lexicographically.
+struct TiebreakKey
+{
+    static constexpr std::size_t SIZE = 6;
+
+    //positions of the tiebreakers in keys built by the constructor below or MtgTiebreaks
+    enum MtgValue
+    {
+        MATCH_SCORE,
+        GAME_SCORE,
+        MATCH_WIN_PERCENTAGE,
+        GAME_WIN_PERCENTAGE,
+        OPP_MATCH_WIN_PERCENTAGE,
+        OPP_GAME_WIN_PERCENTAGE,
+    };
+
+    //positions of the tiebreakers in keys built by ChessTiebreaks
+    enum ChessValue
+    {
+        POINTS,
+        MEDIAN_BUCHHOLZ,
+        BUCHHOLZ,
+        SONNEBORN_BERGER,
+        PROGRESSIVE_SCORE,
+    };
+
+    std::array<std::uint32_t, SIZE> values = {};
+
+    TiebreakKey() = default;
+    TiebreakKey(std::uint32_t matchScore, std::uint32_t gameScore, double matchWinPer, double gameWinPer, double oppMatchWinPer, double oppGameWinPer);
+
+    //percentage between 0 and 1 as a fixed point fraction, NaN (no opponents yet) counts as 0
+    static std::uint32_t fixedPoint(double percentage);
+
+    //the percentage a fixedPoint value stands for
+    static inline double percentage(std::uint32_t fixed)
+    {
+        return static_cast<double>(fixed) / static_cast<double>(UINT32_MAX);
+    }
+
+    inline bool operator==(const TiebreakKey &other) const
+    {
+        return values == other.values;
+    }
+
+    inline bool operator!=(const TiebreakKey &other) const
+    {
+        return values != other.values;
+    }
+
+    inline bool operator<(const TiebreakKey &other) const
+    {
+        return values < other.values;
+    }
+};
@@ -0,0 +1,172 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "standings.hpp"
+
+#include <algorithm>
+#include <initializer_list>
+
+//Tiebreak policies for Standings::calculate.
+//A policy is a type with
+//    static std::uint32_t value(const Standings &standings, const StandingsEntry &entry);
+//returning one tiebreaker for a player, higher is better. Policies are combined with TiebreakChain,
+//earlier policies in the chain are more significant. Everything is resolved at compile time,
+//so the chain is inlined into the standings loop.
+
+struct MatchPointsTiebreak
+{
+    static inline std::uint32_t value(const Standings &, const StandingsEntry &entry)
+    {
+        return entry.matchScore;
+    }
+};
+
+struct GamePointsTiebreak
+{
+    static inline std::uint32_t value(const Standings &, const StandingsEntry &entry)
+    {
+        return entry.gameScore;
+    }
+};
+
+//MtG win percentages, floored at 0.33 by PlayerRecord
+struct MatchWinPercentageTiebreak
+{
+    static inline std::uint32_t value(const Standings &, const StandingsEntry &entry)
+    {
+        return TiebreakKey::fixedPoint(entry.matchWinPercentage);
+    }
+};
+
+struct GameWinPercentageTiebreak
+{
+    static inline std::uint32_t value(const Standings &, const StandingsEntry &entry)
+    {
+        return TiebreakKey::fixedPoint(entry.gameWinPercentage);
+    }
+};
+
+struct OpponentMatchWinPercentageTiebreak
+{
+    static inline std::uint32_t value(const Standings &, const StandingsEntry &entry)
+    {
+        return TiebreakKey::fixedPoint(entry.opponentMatchWinPercentage);
+    }
+};
+
+struct OpponentGameWinPercentageTiebreak
+{
+    static inline std::uint32_t value(const Standings &, const StandingsEntry &entry)
+    {
+        return TiebreakKey::fixedPoint(entry.opponentGameWinPercentage);
+    }
+};
+
+//sum of the opponents' match points
+struct BuchholzTiebreak
+{
+    static inline std::uint32_t value(const Standings &standings, const StandingsEntry &entry)
+    {
+        std::uint32_t sum = 0;
+        for (std::size_t i = entry.firstOpponent; i < entry.firstOpponent + entry.numOpponents; i++)
+            sum += standings.getOpponent(i).matchScore;
+        return sum;
+    }
+};
+
+//Buchholz without the highest and lowest scoring opponents, once there are more than 2 opponents
+struct MedianBuchholzTiebreak
+{
+    static inline std::uint32_t value(const Standings &standings, const StandingsEntry &entry)
+    {
+        if (entry.numOpponents <= 2)
+            return BuchholzTiebreak::value(standings, entry);
+
+        std::uint32_t sum = 0;
+        std::uint32_t highest = 0;
+        std::uint32_t lowest = UINT32_MAX;
+        for (std::size_t i = entry.firstOpponent; i < entry.firstOpponent + entry.numOpponents; i++)
+        {
+            const auto score = standings.getOpponent(i).matchScore;
+            sum += score;
+            highest = std::max(highest, score);
+            lowest = std::min(lowest, score);
+        }
+        return sum - highest - lowest;
+    }
+};
+
+//sum of each opponent's match points weighted by the match points earned against them
+//(full score for a win, a third for a tie with 3/1/0 scoring)
+struct SonnebornBergerTiebreak
+{
+    static inline std::uint32_t value(const Standings &standings, const StandingsEntry &entry)
+    {
+        std::uint32_t sum = 0;
+        for (std::size_t i = entry.firstOpponent; i < entry.firstOpponent + entry.numOpponents; i++)
+            sum += standings.getOpponent(i).matchScore * standings.getOpponent(i).resultPoints;
+        return sum;
+    }
+};
+
+//sum of the player's running match points after each match, rewards scoring early
+struct ProgressiveScoreTiebreak
+{
+    static inline std::uint32_t value(const Standings &standings, const StandingsEntry &entry)
+    {
+        std::int32_t maxMatchNum = entry.player->getMatchResults().size() - 1;
+        if (standings.getMaxMatch() >= 0)
+            maxMatchNum = std::min(standings.getMaxMatch(), maxMatchNum);
+
+        std::uint32_t sum = 0;
+        for (std::int32_t i = 0; i <= maxMatchNum; i++)
+            sum += entry.player->getMatchScore(i);
+        return sum;
+    }
+};
+
+template <typename... Tiebreaks>
+struct TiebreakChain
+{
+    static_assert(sizeof...(Tiebreaks) <= TiebreakKey::SIZE, "TiebreakKey can't hold this many tiebreaks");
+
+    static inline TiebreakKey key(const Standings &standings, const StandingsEntry &entry)
+    {
+        TiebreakKey key;
+        std::size_t i = 0;
+        //braced lists are evaluated in order, so the first tiebreak lands in the most significant value
+        (void)std::initializer_list<int>{(key.values[i++] = Tiebreaks::value(standings, entry), 0)...};
+        return key;
+    }
+};
+
+//match points, game points, MWP, GWP, OMWP, OGWP, the TiebreakKey::MtgValue order
+using MtgTiebreaks = TiebreakChain<MatchPointsTiebreak, GamePointsTiebreak, MatchWinPercentageTiebreak, GameWinPercentageTiebreak,
+                                   OpponentMatchWinPercentageTiebreak, OpponentGameWinPercentageTiebreak>;
+
+//match points, then the usual Swiss chess tiebreaks, see TiebreakKey::ChessValue
+using ChessTiebreaks = TiebreakChain<MatchPointsTiebreak, MedianBuchholzTiebreak, BuchholzTiebreak, SonnebornBergerTiebreak, ProgressiveScoreTiebreak>;
@@ -0,0 +1,205 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "tournament.hpp"
+#include "fieldPairing.hpp"
+#include "tiebreaks.hpp"
+
+#include <algorithm>
+
+std::int32_t Tournament::addPlayer(const std::string &name)
+{
+    const auto id = static_cast<std::int32_t>(m_players.size());
+    m_players.emplace_back(name, id, &m_results);
+    m_players.back().setScoringRules(m_rules);
+    m_active.push_back(true);
+    m_results.resize(m_results.getNumRounds(), m_players.size());
+    return id;
+}
+
+void Tournament::dropPlayer(std::int32_t id)
+{
+    if (isActive(id))
+        m_active[id] = false;
+}
+
+bool Tournament::pairNextRound()
+{
+    const auto matchNum = static_cast<std::int32_t>(m_rounds.size());
+
+    std::vector<std::int32_t> field;
+    for (std::int32_t id = 0; id < getNumPlayers(); id++)
+    {
+        if (m_active[id])
+            field.push_back(id);
+    }
+    if (field.empty())
+        return false;
+
+    auto reng = pairingEngine(m_seed, matchNum);
+    shuffleField(field, reng);
+
+    std::vector<Pairing> pairings;
+    if (matchNum == 0)
+    {
+        for (std::size_t i = 0; i < field.size(); i += 2)
+            pairings.push_back(Pairing{field[i], i + 1 < field.size() ? field[i + 1] : -1});
+    }
+    else
+    {
+        const auto scoreMatch = matchNum - 1;
+        //stable, so players with the same score keep the shuffled order on every standard library
+        std::stable_sort(field.begin(), field.end(), [this, scoreMatch](std::int32_t a, std::int32_t b)
+                         { return m_players[a].getMatchScore(scoreMatch) > m_players[b].getMatchScore(scoreMatch); }); //use > for reverse sort
+
+        std::vector<std::int64_t> scores;
+        std::vector<std::int64_t> byes;
+        scores.reserve(field.size());
+        byes.reserve(field.size());
+        for (const auto id : field)
+        {
+            scores.push_back(m_players[id].getMatchScore(scoreMatch));
+            byes.push_back(m_players[id].receivedByes(scoreMatch));
+        }
+
+        const auto mates = weightedPairing(scores, byes, [this, &field, scoreMatch](std::int32_t i, std::int32_t j)
+                                           { return m_players[field[i]].timesPlayed(field[j], scoreMatch); });
+        if (mates.empty())
+            return false;
+
+        const auto numPlayers = static_cast<std::int32_t>(field.size());
+        std::int32_t byePlayer = -1;
+        for (std::int32_t i = 0; i < numPlayers; i++)
+        {
+            if (mates[i] == numPlayers)
+                byePlayer = i;
+            else if (mates[i] > i)
+                pairings.push_back(Pairing{field[i], field[mates[i]]});
+        }
+        if (byePlayer >= 0)
+            pairings.push_back(Pairing{field[byePlayer], -1});
+    }
+
+    m_results.resize(matchNum + 1, m_players.size());
+    for (auto &pairing : pairings)
+    {
+        if (pairing.player2 >= 0)
+            continue;
+        MatchResult bye;
+        bye.bye = true;
+        bye.matchWin = true;
+        bye.wins = m_rules.byeGameWins;
+        m_players[pairing.player1].setMatchResult(matchNum, bye);
+        pairing.reported = true;
+    }
+    m_rounds.emplace_back(std::move(pairings));
+    return true;
+}
+
+bool Tournament::setResult(std::int32_t round, std::size_t pairing, std::uint32_t wins, std::uint32_t losses, std::uint32_t ties)
+{
+    if (round < 0 || static_cast<std::size_t>(round) >= m_rounds.size() || pairing >= m_rounds[round].getNumPairings())
+        return false;
+    const auto &players = m_rounds[round].getPairing(pairing);
+    if (players.player2 < 0) //byes are scored when paired
+        return false;
+
+    MatchResult res;
+    res.opponent = players.player2;
+    res.wins = wins;
+    res.losses = losses;
+    res.ties = ties;
+    res.matchWin = res.wins > res.losses;
+    res.matchTie = res.wins == res.losses;
+    m_players[players.player1].setMatchResult(round, res);
+
+    std::swap(res.wins, res.losses);
+    res.opponent = players.player1;
+    res.matchWin = !res.matchWin && !res.matchTie;
+    m_players[players.player2].setMatchResult(round, res);
+
+    m_rounds[round].setReported(pairing);
+    return true;
+}
+
+bool Tournament::validateRound(std::int32_t round, std::string *reason) const
+{
+    if (round < 0 || round >= m_results.getNumRounds())
+    {
+        *reason = "Round " + std::to_string(round) + " hasn't been paired.";
+        return false;
+    }
+
+    std::size_t id = 0;
+    const auto error = m_results.checkRound(round, m_rules.bestOf, &id);
+    if (error == RoundError::None)
+        return true;
+
+    const auto prefix = "Round " + std::to_string(round) + ", player " + std::to_string(id);
+    if (error == RoundError::NoOpponent)
+        *reason = prefix + " marked as played, but no opponent was set.";
+    else if (error == RoundError::OpponentMismatch)
+        *reason = prefix + " has an opponent who didn't play them.";
+    else if (error == RoundError::TooManyGames)
+        *reason = prefix + " has a total of more than " + std::to_string(m_rules.bestOf) + " wins or losses.";
+    else
+        *reason = prefix + " has different games than their opponent.";
+    return false;
+}
+
+OpponentAverages Tournament::getOpponentAverages(std::int32_t id, std::int32_t maxMatch) const
+{
+    const auto player = getPlayer(id);
+    if (player == nullptr)
+        return OpponentAverages();
+
+    return averageOpponents(player->getMatchResults(), maxMatch, [this, maxMatch](const PackedMatchResult &result, double &matchWinPer, double &gameWinPer)
+                            {
+                                const auto opponent = getPlayer(result.opponent());
+                                if (opponent == nullptr)
+                                    return false;
+                                matchWinPer = opponent->getMatchWinPercentage(maxMatch);
+                                gameWinPer = opponent->getGameWinPercentage(maxMatch);
+                                return true;
+                            });
+}
+
+std::vector<std::int32_t> Tournament::getStandings(std::int32_t maxMatch) const
+{
+    std::vector<const PlayerRecord *> players;
+    players.reserve(m_players.size());
+    for (const auto &player : m_players)
+        players.push_back(&player);
+
+    //every player is in the list, dropped players included, so it doubles as the lookup by id
+    Standings standings;
+    standings.calculate<MtgTiebreaks>(players, players, maxMatch);
+
+    std::vector<std::int32_t> order;
+    order.reserve(players.size());
+    for (const auto &entry : standings.getEntries())
+        order.push_back(entry.player->getId());
+    return order;
+}
@@ -0,0 +1,125 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2021 Dan Logan
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "opponentAverages.hpp"
+#include "playerRecord.hpp"
+#include "resultMatrix.hpp"
+#include "round.hpp"
+#include "scoringRules.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//A whole tournament as plain values, part of the core library (swisscore) that needs no Qt.
+//Players are PlayerRecords indexed by id and referred to by id everywhere, rounds are paired
+//the way Match pairs with PairingMethod::WeightedMatching, so a seed gives the same pairings in both.
+class Tournament
+{
+public:
+    explicit Tournament(const ScoringRules &rules = BestOf3Scoring::rules(), std::uint64_t seed = 0) : m_rules(rules), m_seed(seed) {}
+
+    //the records point at m_results
+    Tournament(const Tournament &) = delete;
+    Tournament &operator=(const Tournament &) = delete;
+
+    //returns the id of the new player
+    std::int32_t addPlayer(const std::string &name);
+
+    //dropped players keep their results but aren't paired any more
+    void dropPlayer(std::int32_t id);
+
+    inline bool isActive(std::int32_t id) const
+    {
+        return id >= 0 && static_cast<std::size_t>(id) < m_active.size() && m_active[id];
+    }
+
+    //nullptr for unknown ids
+    inline const PlayerRecord *getPlayer(std::int32_t id) const
+    {
+        if (id < 0 || static_cast<std::size_t>(id) >= m_players.size())
+            return nullptr;
+        return &m_players[id];
+    }
+
+    //including dropped players
+    inline std::int32_t getNumPlayers() const
+    {
+        return static_cast<std::int32_t>(m_players.size());
+    }
+
+    inline const std::vector<Round> &getRounds() const
+    {
+        return m_rounds;
+    }
+
+    //every result, one row per round
+    inline const ResultMatrix &getResults() const
+    {
+        return m_results;
+    }
+
+    inline const ScoringRules &getScoringRules() const
+    {
+        return m_rules;
+    }
+
+    //pairs the active players for a new round, a bye is scored right away
+    //returns false if there is no one to pair or no pairing was found
+    bool pairNextRound();
+
+    //result of a pairing as seen by player1, also stored for player2 with wins and losses swapped
+    bool setResult(std::int32_t round, std::size_t pairing, std::uint32_t wins, std::uint32_t losses, std::uint32_t ties);
+
+    //checks both sides of every played match of a round agree and no match decided more games than the format allows
+    //reason is set to the first problem found
+    bool validateRound(std::int32_t round, std::string *reason) const;
+
+    OpponentAverages getOpponentAverages(std::int32_t id, std::int32_t maxMatch = -1) const;
+
+    inline double getOpponentMatchWinPercentage(std::int32_t id, std::int32_t maxMatch = -1) const
+    {
+        return getOpponentAverages(id, maxMatch).matchWinPercentage;
+    }
+
+    inline double getOpponentGameWinPercentage(std::int32_t id, std::int32_t maxMatch = -1) const
+    {
+        return getOpponentAverages(id, maxMatch).gameWinPercentage;
+    }
+
+    //ids of every player, best first, counting matches up to maxMatch (-1 for all matches)
+    //ranked by Standings with MtgTiebreaks, the same ranking the application shows, equal keys keep id order
+    std::vector<std::int32_t> getStandings(std::int32_t maxMatch = -1) const;
+
+private:
+    ScoringRules m_rules;
+    std::uint64_t m_seed = 0;
+    std::vector<PlayerRecord> m_players; //by id
+    std::vector<bool> m_active; //by id
+    std::vector<Round> m_rounds;
+    ResultMatrix m_results; //the results of m_players, round-major for round-level work
+};